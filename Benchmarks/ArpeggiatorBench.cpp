@@ -0,0 +1,39 @@
+#include "Bench.h"
+#include "DSP/Arpeggiator/Arpeggiator.h"
+
+// Arpeggiator::processBlock per mode, four held notes, fast rate (steps land inside
+// most blocks), per block size
+DEEPMIND_BENCHMARK(arpeggiator)
+{
+    using DeepMindDSP::ArpMode;
+
+    const std::pair<ArpMode, const char*> modes[] = {
+        { ArpMode::Up, "up" }, { ArpMode::Down, "down" }, { ArpMode::UpDown, "updown" },
+        { ArpMode::Random, "random" }, { ArpMode::Chord, "chord" }, { ArpMode::Pattern, "pattern" }
+    };
+
+    for (auto [mode, modeName] : modes)
+    {
+        for (int blockSize : bench::blockSizes)
+        {
+            DeepMindDSP::Arpeggiator arp;
+            arp.prepare({ 48000.0, (juce::uint32)blockSize, 2 });
+            arp.setBypass(false);
+            arp.setMode(mode);
+            arp.setRate(24.0f);
+            arp.setOctaveRange(2);
+
+            juce::MidiBuffer midi;
+            for (int note : { 48, 52, 55, 59 })
+                midi.addEvent(juce::MidiMessage::noteOn(1, note, 0.8f), 0);
+            arp.processBlock(midi, blockSize); // Hold the chord
+
+            const double ns = bench::measureNs(bench::iterationsFor(blockSize, 1 << 22), [&] {
+                midi.clear();
+                arp.processBlock(midi, blockSize);
+            });
+
+            bench::report(juce::String("arp/") + modeName + "/block_" + juce::String(blockSize), ns);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <JuceHeader.h>
+#include <chrono>
+#include <functional>
+
+// Minimal benchmark harness for DeepMindSynthBench.
+// Benchmarks register themselves with DEEPMIND_BENCHMARK and report through bench::report().
+// Results can be written as JSON and compared against a saved baseline (see BenchMain.cpp).
+namespace bench
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Runs fn a few times to warm caches, then 'iterations' times.
+    // Returns mean nanoseconds per call.
+    template <typename Fn>
+    double measureNs(int iterations, Fn&& fn)
+    {
+        for (int i = 0; i < juce::jmin(iterations, 8); ++i)
+            fn();
+
+        auto start = Clock::now();
+        for (int i = 0; i < iterations; ++i)
+            fn();
+        auto end = Clock::now();
+
+        return std::chrono::duration<double, std::nano>(end - start).count() / (double)juce::jmax(1, iterations);
+    }
+
+    // What the per-module benchmarks sweep: host block sizes and simultaneous voices
+    inline constexpr int blockSizes[] = { 32, 128, 512 };
+    inline constexpr int voiceCounts[] = { 1, 4, 12 };
+
+    // Calls needed for roughly 'totalSamples' samples of work (at least 'minimum')
+    inline int iterationsFor(int samplesPerCall, int totalSamples = 1 << 21, int minimum = 20)
+    {
+        return juce::jmax(minimum, totalSamples / juce::jmax(1, samplesPerCall));
+    }
+
+    // "1.23 ns/sample" for a call that processed 'samplesPerCall' samples
+    inline juce::String perSample(double nsPerCall, int samplesPerCall)
+    {
+        return juce::String(nsPerCall / juce::jmax(1, samplesPerCall), 2) + " ns/sample";
+    }
+
+    // Prints one result line and keeps it for the JSON output / baseline check.
+    // nsPerOp == 0 marks an informational line (not compared).
+    void report(const juce::String& name, double nsPerOp, const juce::String& note = {});
+
+    // Reports a failed check (property tests) and marks the run as failed
+    void fail(const juce::String& name, const juce::String& reason);
+
+    struct Registration
+    {
+        Registration(const char* name, void (*fn)());
+    };
+
+    int runAll(const juce::String& filter);
+
+    // All reported results as JSON: { "cpu": ..., "results": { name: { "ns_per_op", "note", "informational" } } }
+    juce::var resultsAsJson();
+
+    // Prints each result against the baseline file's; returns how many got slower
+    // than thresholdPercent. Informational rows are skipped on both sides.
+    int compareWithBaseline(const juce::var& baseline, double thresholdPercent);
+
+    // "--json out.json" or "--json=out.json" -> "out.json". valueIndex gets the
+    // index of a separate value argument (-1 if none).
+    juce::String getOptionValue(const juce::ArgumentList& args, const juce::String& option, int* valueIndex = nullptr);
+}
+
+#define DEEPMIND_BENCHMARK(benchName) \
+    static void benchName(); \
+    static bench::Registration benchName##_registration (#benchName, benchName); \
+    static void benchName()
@@ -0,0 +1,215 @@
+#include "Bench.h"
+#include <cstdio>
+#include <vector>
+
+namespace bench
+{
+    namespace
+    {
+        struct Entry
+        {
+            const char* name;
+            void (*fn)();
+        };
+
+        struct Result
+        {
+            juce::String name;
+            double nsPerOp;
+            juce::String note;
+        };
+
+        std::vector<Entry>& getRegistry()
+        {
+            static std::vector<Entry> registry;
+            return registry;
+        }
+
+        std::vector<Result>& getResults()
+        {
+            static std::vector<Result> results;
+            return results;
+        }
+
+        bool anyFailed = false;
+    }
+
+    juce::String getOptionValue(const juce::ArgumentList& args, const juce::String& option, int* valueIndex)
+    {
+        for (int i = 0; i < args.size(); ++i)
+        {
+            auto& arg = args.arguments.getReference(i);
+            if (arg.text == option)
+            {
+                // "--json out.json"
+                if (i + 1 < args.size() && !args.arguments.getReference(i + 1).isOption())
+                {
+                    if (valueIndex != nullptr) *valueIndex = i + 1;
+                    return args.arguments.getReference(i + 1).text;
+                }
+                return {};
+            }
+
+            if (arg.text.startsWith(option + "="))
+                return arg.text.fromFirstOccurrenceOf("=", false, false); // "--json=out.json"
+        }
+        return {};
+    }
+
+    Registration::Registration(const char* name, void (*fn)())
+    {
+        getRegistry().push_back({ name, fn });
+    }
+
+    void report(const juce::String& name, double nsPerOp, const juce::String& note)
+    {
+        getResults().push_back({ name, nsPerOp, note });
+        std::printf("%-48s %14.1f ns/op  %s\n", name.toRawUTF8(), nsPerOp, note.toRawUTF8());
+    }
+
+    void fail(const juce::String& name, const juce::String& reason)
+    {
+        anyFailed = true;
+        std::printf("%-48s FAILED: %s\n", name.toRawUTF8(), reason.toRawUTF8());
+    }
+
+    int runAll(const juce::String& filter)
+    {
+        for (auto& e : getRegistry())
+        {
+            if (filter.isNotEmpty() && !juce::String(e.name).containsIgnoreCase(filter))
+                continue;
+            e.fn();
+        }
+        return anyFailed ? 1 : 0;
+    }
+
+    juce::var resultsAsJson()
+    {
+        auto* results = new juce::DynamicObject();
+        for (auto& r : getResults())
+        {
+            auto* entry = new juce::DynamicObject();
+            entry->setProperty("ns_per_op", r.nsPerOp);
+            if (r.nsPerOp <= 0.0)
+                entry->setProperty("informational", true); // Never compared
+            if (r.note.isNotEmpty())
+                entry->setProperty("note", r.note);
+            results->setProperty(r.name, juce::var(entry));
+        }
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty("cpu", juce::SystemStats::getCpuModel());
+        root->setProperty("cores", juce::SystemStats::getNumPhysicalCpus());
+        root->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+        root->setProperty("results", juce::var(results));
+        return juce::var(root);
+    }
+
+    int compareWithBaseline(const juce::var& baseline, double thresholdPercent)
+    {
+        auto* previous = baseline["results"].getDynamicObject();
+        jassert(previous != nullptr); // main() rejects baselines without results
+        if (previous == nullptr) return 0;
+
+        std::printf("\n%-48s %14s %14s %9s\n", "vs baseline", "baseline ns", "now ns", "change");
+
+        int regressions = 0, informational = 0, missing = 0;
+        for (auto& r : getResults())
+        {
+            // Informational rows (nsPerOp == 0: error figures, packet counts, kernel
+            // names) say nothing about speed, here or in the baseline
+            const auto stored = previous->getProperty(r.name);
+            if (r.nsPerOp <= 0.0 || (bool)stored["informational"])
+            {
+                ++informational;
+                continue;
+            }
+
+            const double before = stored["ns_per_op"];
+            if (before <= 0.0)
+            {
+                ++missing; // New since the baseline
+                continue;
+            }
+
+            const double change = (r.nsPerOp / before - 1.0) * 100.0;
+            const bool regressed = change > thresholdPercent;
+            regressions += regressed ? 1 : 0;
+
+            std::printf("%-48s %14.1f %14.1f %+8.1f%%%s\n", r.name.toRawUTF8(), before, r.nsPerOp, change,
+                        regressed ? "  REGRESSION" : "");
+        }
+
+        std::printf("%d regression(s) above %.1f%%; %d informational row(s) not compared, %d not in the baseline\n",
+                    regressions, thresholdPercent, informational, missing);
+        return regressions;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Usage: DeepMindSynthBench [filter] [--json out.json] [--save-baseline base.json]
+    //                           [--baseline base.json] [--threshold 10]
+    // Options take their value as "--json out.json" or "--json=out.json".
+    // --baseline fails the run (exit 2) when any result is more than 'threshold' percent
+    // slower than the same name in the baseline. Baselines are plain --json output,
+    // recorded with --save-baseline on the machine they're compared on. A missing,
+    // unreadable or empty baseline is an error (exit 3), never a pass with nothing compared.
+    juce::ScopedJuceInitialiser_GUI juceInit; // APVTS needs a MessageManager
+    juce::ArgumentList args(argc, argv);
+
+    // Collect the option values first so "--json out.json" isn't taken as the filter
+    static constexpr const char* options[] = { "--json", "--save-baseline", "--baseline", "--threshold" };
+    juce::StringPairArray values;
+    juce::Array<int> valueIndices;
+    for (auto option : options)
+    {
+        int valueIndex = -1;
+        auto value = bench::getOptionValue(args, option, &valueIndex);
+        if (value.isNotEmpty()) values.set(option, value);
+        if (valueIndex >= 0) valueIndices.add(valueIndex);
+    }
+
+    juce::String filter;
+    for (int i = 0; i < args.size(); ++i)
+        if (!args.arguments.getReference(i).isOption() && !valueIndices.contains(i))
+            filter = args.arguments.getReference(i).text;
+
+    int status = bench::runAll(filter);
+
+    auto json = juce::JSON::toString(bench::resultsAsJson());
+    for (auto option : { "--json", "--save-baseline" })
+    {
+        if (!values.containsKey(option)) continue;
+
+        auto file = juce::File::getCurrentWorkingDirectory().getChildFile(values[option]);
+        if (!file.replaceWithText(json))
+            std::printf("Could not write %s\n", file.getFullPathName().toRawUTF8());
+    }
+
+    if (values.containsKey("--baseline"))
+    {
+        auto file = juce::File::getCurrentWorkingDirectory().getChildFile(values["--baseline"]);
+        if (!file.existsAsFile())
+        {
+            std::printf("No baseline at %s: nothing compared. Record one with --save-baseline.\n",
+                        file.getFullPathName().toRawUTF8());
+            return 3;
+        }
+
+        auto baseline = juce::JSON::parse(file);
+        auto* stored = baseline["results"].getDynamicObject();
+        if (stored == nullptr || stored->getProperties().isEmpty())
+        {
+            std::printf("Baseline %s has no results: nothing compared\n", file.getFullPathName().toRawUTF8());
+            return 3;
+        }
+
+        const double threshold = values.containsKey("--threshold") ? values["--threshold"].getDoubleValue() : 10.0;
+        if (bench::compareWithBaseline(baseline, threshold) > 0 && status == 0)
+            status = 2;
+    }
+
+    return status;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <JuceHeader.h>
+#include "Data/DeepMindParameters.h"
+
+// Bare AudioProcessor carrying the real DeepMind parameter layout,
+// so Data/ classes can be benchmarked without the synth engine or editor.
+class BenchProcessor : public juce::AudioProcessor
+{
+public:
+    BenchProcessor()
+        : AudioProcessor(BusesProperties().withOutput("Output", juce::AudioChannelSet::stereo(), true)),
+          apvts(*this, nullptr, "Parameters", DeepMindParams::createParameterLayout())
+    {
+    }
+
+    const juce::String getName() const override { return "Bench"; }
+    void prepareToPlay(double, int) override {}
+    void releaseResources() override {}
+    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {}
+    double getTailLengthSeconds() const override { return 0.0; }
+    bool acceptsMidi() const override { return true; }
+    bool producesMidi() const override { return false; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+    bool hasEditor() const override { return false; }
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+    void getStateInformation(juce::MemoryBlock&) override {}
+    void setStateInformation(const void*, int) override {}
+
+    // Randomise every parameter (so state round-trips are not trivially default)
+    void randomise(juce::Random& rng)
+    {
+        for (auto* p : getParameters())
+            p->setValueNotifyingHost(rng.nextFloat());
+    }
+
+    juce::AudioProcessorValueTreeState apvts;
+};
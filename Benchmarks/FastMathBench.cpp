@@ -0,0 +1,39 @@
+#include "Bench.h"
+#include "DSP/FastMath.h"
+#include <cmath>
+#include <vector>
+
+// FastMath::exp2 vs std::pow: accuracy in cents and cost per call
+DEEPMIND_BENCHMARK(fast_exp2)
+{
+    using namespace DeepMindDSP;
+
+    // Accuracy over +/- 10 octaves (far beyond any pitch path)
+    double maxCents = 0.0;
+    for (double x = -10.0; x < 10.0; x += 1.0e-4)
+    {
+        double ratio = FastMath::exp2((float)x) / std::exp2((double)(float)x);
+        maxCents = std::max(maxCents, std::abs(1200.0 * std::log2(ratio)));
+    }
+
+    bench::report("fastmath/exp2_max_error", 0.0, juce::String(maxCents, 4) + " cent");
+    if (maxCents >= 0.1)
+        bench::fail("fastmath/exp2_max_error", "error above 0.1 cent");
+
+    // Cost: one unison stack (12 layers) of semitone -> ratio conversions
+    juce::Random rng(5);
+    std::vector<float> semitones(12), ratios(12);
+    for (auto& s : semitones) s = rng.nextFloat() * 2.0f - 1.0f;
+
+    const int iterations = 200000;
+    auto powNs = bench::measureNs(iterations, [&] {
+        for (size_t i = 0; i < semitones.size(); ++i)
+            ratios[i] = std::pow(2.0f, semitones[i] / 12.0f);
+    });
+    auto fastNs = bench::measureNs(iterations, [&] {
+        FastMath::semitonesToRatio(semitones.data(), ratios.data(), (int)semitones.size());
+    });
+
+    bench::report("fastmath/std_pow_x12", powNs);
+    bench::report("fastmath/exp2_x12", fastNs, juce::String(powNs / juce::jmax(1.0e-9, fastNs), 1) + "x faster");
+}
@@ -0,0 +1,51 @@
+#include "Bench.h"
+#include "DSP/Filters/MultiFilter.h"
+#include <vector>
+
+// MultiFilter per FilterType: one filter per voice, white noise in (refilled each
+// call so the state never decays into denormals)
+DEEPMIND_BENCHMARK(filter)
+{
+    using DeepMindDSP::FilterType;
+    juce::ScopedNoDenormals noDenormals;
+    juce::Random rng(22);
+
+    const std::pair<FilterType, const char*> types[] = {
+        { FilterType::Jupiter, "jupiter" }, { FilterType::MS20, "ms20" },
+        { FilterType::Acid303, "acid303" }, { FilterType::DeepMind, "deepmind" }
+    };
+
+    for (auto [type, typeName] : types)
+    {
+        for (int blockSize : bench::blockSizes)
+        {
+            juce::dsp::ProcessSpec spec { 48000.0, (juce::uint32)blockSize, 1 };
+            std::vector<float> noise((size_t)blockSize), buffer((size_t)blockSize);
+            for (auto& x : noise) x = rng.nextFloat() * 2.0f - 1.0f;
+
+            for (int voices : bench::voiceCounts)
+            {
+                std::vector<DeepMindDSP::MultiFilter> filters((size_t)voices);
+                for (auto& filter : filters)
+                {
+                    filter.prepare(spec);
+                    filter.setType(type);
+                    filter.setCutoff(300.0f + rng.nextFloat() * 4000.0f);
+                    filter.setResonance(0.6f);
+                    filter.setDrive(0.3f);
+                }
+
+                const double ns = bench::measureNs(bench::iterationsFor(blockSize * voices), [&] {
+                    for (auto& filter : filters)
+                    {
+                        std::copy(noise.begin(), noise.end(), buffer.begin());
+                        filter.process(buffer.data(), blockSize);
+                    }
+                });
+
+                bench::report(juce::String("filter/") + typeName + "/block_" + juce::String(blockSize) + "/voices_" + juce::String(voices),
+                              ns, bench::perSample(ns / voices, blockSize) + " per voice");
+            }
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#include "Bench.h"
+#include "DSP/Effects/FxChain.h"
+#include <vector>
+
+namespace
+{
+    // Times one effect on a stereo block of noise (refilled each call), per block size
+    template <typename Effect, typename Setup>
+    void benchEffect(const char* name, Setup&& setup)
+    {
+        juce::ScopedNoDenormals noDenormals;
+        juce::Random rng(24);
+
+        for (int blockSize : bench::blockSizes)
+        {
+            juce::dsp::ProcessSpec spec { 48000.0, (juce::uint32)blockSize, 2 };
+            juce::AudioBuffer<float> noise(2, blockSize), buffer(2, blockSize);
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    noise.setSample(ch, i, rng.nextFloat() * 0.5f - 0.25f);
+
+            Effect effect;
+            effect.prepare(spec);
+            effect.reset();
+            setup(effect);
+
+            const double ns = bench::measureNs(bench::iterationsFor(blockSize), [&] {
+                buffer.makeCopyOf(noise, true);
+                juce::dsp::AudioBlock<float> block(buffer);
+                effect.process(block);
+            });
+
+            bench::report(juce::String("fx/") + name + "/block_" + juce::String(blockSize), ns,
+                          bench::perSample(ns, blockSize));
+        }
+    }
+}
+
+// Each FxChain processor on its own, then the whole chain in both routings
+DEEPMIND_BENCHMARK(fx)
+{
+    using namespace DeepMindDSP;
+
+    benchEffect<Distortion>("distortion", [](auto& fx) { fx.setParams(0.6f, 0.5f, 1.0f, static_cast<DistortionType>(0)); });
+    benchEffect<DeepMindPhaser>("phaser", [](auto& fx) { fx.setParams(0.5f, 0.7f, 0.5f, 0.5f); });
+    benchEffect<DeepMindChorus>("chorus", [](auto& fx) { fx.setParams(0.8f, 0.5f, 0.5f); });
+    benchEffect<DeepMindDelay>("delay", [](auto& fx) { fx.setParams(0.35f, 0.5f, 0.4f); });
+    benchEffect<DeepMindReverb>("reverb", [](auto& fx) { fx.setParams(0.7f, 0.4f, 0.3f); });
+    benchEffect<DeepMindEQ>("eq", [](auto& fx) { fx.setParams(3.0f, 100.0f, -2.0f, 500.0f, 0.7f, 2.0f, 3000.0f, 0.7f, -3.0f, 10000.0f); });
+
+    for (int routing : { 0, 1 })
+    {
+        benchEffect<FxChain>(routing == 0 ? "chain_series" : "chain_parallel", [routing](auto& fx) {
+            fx.setRoutingMode(routing);
+            fx.setChorusParams(0.8f, 0.5f, 0.5f);
+            fx.setDelayParams(0.35f, 0.5f, 0.4f);
+            fx.setReverbParams(0.7f, 0.4f, 0.3f);
+        });
+    }
+}
@@ -0,0 +1,37 @@
+#include "Bench.h"
+#include "DSP/Modulation/ModMatrix.h"
+#include <vector>
+
+// ModMatrix::process: once per voice per control block, with 0 / 4 / 8 slots routed
+DEEPMIND_BENCHMARK(mod_matrix)
+{
+    juce::Random rng(23);
+
+    // A spread of source values so the call can't be folded away
+    std::vector<DeepMindDSP::ModSources> sources(64);
+    for (auto& s : sources)
+    {
+        s.lfo1 = rng.nextFloat(); s.lfo2 = rng.nextFloat(); s.envMod = rng.nextFloat();
+        s.velocity = rng.nextFloat(); s.modWheel = rng.nextFloat(); s.keyTrack = rng.nextFloat();
+        s.pitchBend = rng.nextFloat() * 2.0f - 1.0f; s.pressure = rng.nextFloat();
+    }
+
+    for (int activeSlots : { 0, 4, 8 })
+    {
+        DeepMindDSP::ModMatrix matrix;
+        for (int slot = 0; slot < activeSlots; ++slot)
+            matrix.setSlot(slot, 1 + rng.nextInt(12), 1 + rng.nextInt(5), rng.nextFloat() * 2.0f - 1.0f);
+
+        DeepMindDSP::ModDestinations destinations;
+        volatile float sink = 0.0f;
+        size_t next = 0;
+
+        const double ns = bench::measureNs(1000000, [&] {
+            matrix.process(sources[next++ & 63], destinations);
+            sink = sink + destinations.vcfCutoff;
+        });
+        juce::ignoreUnused(sink);
+
+        bench::report("modmatrix/slots_" + juce::String(activeSlots), ns);
+    }
+}
@@ -0,0 +1,101 @@
+#include "Bench.h"
+#include "BenchProcessor.h"
+#include "Data/StateSerializer.h"
+#include "Data/OscFeedbackSender.h"
+#include <atomic>
+
+namespace
+{
+    // Counts packets/messages arriving on the loopback port and the latency of each
+    // message relative to the last parameter change the benchmark made.
+    struct LoopbackCounter : juce::OSCReceiver::Listener<juce::OSCReceiver::RealtimeCallback>
+    {
+        void oscMessageReceived(const juce::OSCMessage&) override { packets++; record(1); }
+        void oscBundleReceived(const juce::OSCBundle& bundle) override { packets++; record(bundle.size()); }
+
+        void record(int numMessages)
+        {
+            messages += numMessages;
+            auto latency = juce::Time::getMillisecondCounterHiRes() - lastChangeMs.load();
+            latencySumMs = latencySumMs.load() + latency;
+            latencyCount++;
+            if (latency > maxLatencyMs.load()) maxLatencyMs = latency;
+        }
+
+        void reset()
+        {
+            packets = 0; messages = 0; latencyCount = 0;
+            latencySumMs = 0.0; maxLatencyMs = 0.0;
+        }
+
+        std::atomic<int> packets { 0 }, messages { 0 }, latencyCount { 0 };
+        std::atomic<double> latencySumMs { 0.0 }, maxLatencyMs { 0.0 }, lastChangeMs { 0.0 };
+    };
+}
+
+// OSC feedback TX: packets per second and change -> receive latency over UDP loopback
+DEEPMIND_BENCHMARK(osc_feedback)
+{
+    const int port = 39000;
+    BenchProcessor proc;
+    data::StateSerializer layout(proc);
+
+    LoopbackCounter counter;
+    juce::OSCReceiver receiver;
+    receiver.addListener(&counter);
+    if (!receiver.connect(port))
+        return bench::fail("osc/loopback", "could not bind port " + juce::String(port));
+
+    data::OscFeedbackSender feedback(layout);
+    feedback.setRate(60.0);
+    if (!feedback.connect("127.0.0.1", port))
+        return bench::fail("osc/loopback", "could not connect sender");
+
+    auto settle = [] { juce::Thread::sleep(100); };
+    auto* swept = proc.getParameters()[0];
+    juce::Random rng(99);
+
+    // --- Sweep: one parameter changed every 1 ms for 1 s (tablet fader) ---
+    settle();
+    counter.reset();
+    const int sweepChanges = 1000;
+    for (int i = 0; i < sweepChanges; ++i)
+    {
+        counter.lastChangeMs = juce::Time::getMillisecondCounterHiRes();
+        swept->setValueNotifyingHost((float)i / sweepChanges);
+        juce::Thread::sleep(1);
+    }
+    settle();
+
+    auto latencyNote = [&counter] {
+        int n = juce::jmax(1, counter.latencyCount.load());
+        return "avg latency " + juce::String(counter.latencySumMs.load() / n, 2)
+             + " ms, max " + juce::String(counter.maxLatencyMs.load(), 2) + " ms";
+    };
+
+    bench::report("osc/sweep_packets_per_s", 0.0, juce::String(counter.packets.load()) + " packets for "
+                  + juce::String(sweepChanges) + " changes, " + latencyNote());
+    if (counter.packets.load() > 2 * 60 * 2) // ~60/s over a sweep that takes 1-2 s with sleep granularity
+        bench::fail("osc/sweep_packets_per_s", "not coalesced (expected ~60 packets per second)");
+
+    // --- Preset load: every parameter at once ---
+    settle();
+    counter.reset();
+    counter.lastChangeMs = juce::Time::getMillisecondCounterHiRes();
+    proc.randomise(rng);
+    settle();
+
+    bench::report("osc/preset_burst", 0.0, juce::String(counter.packets.load()) + " packets, "
+                  + juce::String(counter.messages.load()) + " messages for "
+                  + juce::String(layout.getNumParameters()) + " parameters, " + latencyNote());
+    if (counter.messages.load() < layout.getNumParameters())
+        bench::fail("osc/preset_burst", "missing parameter messages");
+
+    // --- Cost of the notification on the changing thread ---
+    auto notifyNs = bench::measureNs(100000, [&] { swept->setValueNotifyingHost(rng.nextFloat()); });
+    bench::report("osc/notify_cost", notifyNs, "setValueNotifyingHost incl. dirty bit");
+
+    feedback.disconnect();
+    receiver.removeListener(&counter);
+    receiver.disconnect();
+}
@@ -0,0 +1,36 @@
+#include "Bench.h"
+#include "DSP/Oscillators/DeepMindOsc.h"
+#include <vector>
+
+// DeepMindOsc: a voice's worth of oscillators (2 per voice) per block size
+DEEPMIND_BENCHMARK(oscillator)
+{
+    juce::ScopedNoDenormals noDenormals;
+    juce::Random rng(21);
+
+    for (int blockSize : bench::blockSizes)
+    {
+        juce::dsp::ProcessSpec spec { 48000.0, (juce::uint32)blockSize, 1 };
+        std::vector<float> buffer((size_t)blockSize);
+
+        for (int voices : bench::voiceCounts)
+        {
+            std::vector<DeepMindDSP::DeepMindOsc> oscs((size_t)(voices * 2));
+            for (auto& osc : oscs)
+            {
+                osc.prepare(spec);
+                osc.setFrequency(55.0f + rng.nextFloat() * 880.0f);
+                osc.setShape(rng.nextFloat());
+            }
+
+            const double ns = bench::measureNs(bench::iterationsFor(blockSize * voices), [&] {
+                std::fill(buffer.begin(), buffer.end(), 0.0f);
+                for (auto& osc : oscs)
+                    osc.process(buffer.data(), blockSize, 0.1f);
+            });
+
+            bench::report("osc/block_" + juce::String(blockSize) + "/voices_" + juce::String(voices), ns,
+                          bench::perSample(ns / voices, blockSize) + " per voice");
+        }
+    }
+}
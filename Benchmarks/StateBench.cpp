@@ -0,0 +1,51 @@
+#include "Bench.h"
+#include "BenchProcessor.h"
+#include "Data/StateSerializer.h"
+
+// Plugin state save/load: legacy XML (copyXmlToBinary) vs binary StateSerializer
+DEEPMIND_BENCHMARK(state_save_load)
+{
+    BenchProcessor proc;
+    data::StateSerializer serializer(proc);
+    juce::Random rng(1234);
+    proc.randomise(rng);
+
+    const int iterations = 2000;
+
+    // --- XML (legacy path) ---
+    juce::MemoryBlock xmlData;
+    auto xmlSave = bench::measureNs(iterations, [&] {
+        xmlData.reset();
+        auto state = proc.apvts.copyState();
+        std::unique_ptr<juce::XmlElement> xml(state.createXml());
+        juce::AudioProcessor::copyXmlToBinary(*xml, xmlData);
+    });
+
+    auto xmlLoad = bench::measureNs(iterations, [&] {
+        std::unique_ptr<juce::XmlElement> xml(juce::AudioProcessor::getXmlFromBinary(xmlData.getData(), (int)xmlData.getSize()));
+        if (xml != nullptr)
+            proc.apvts.replaceState(juce::ValueTree::fromXml(*xml));
+    });
+
+    // --- Binary ---
+    juce::MemoryBlock binData;
+    auto binSave = bench::measureNs(iterations, [&] { serializer.write(binData); });
+    auto binLoad = bench::measureNs(iterations, [&] { serializer.read(binData.getData(), (int)binData.getSize()); });
+
+    bench::report("state/xml_save", xmlSave, juce::String((int)xmlData.getSize()) + " bytes");
+    bench::report("state/xml_load", xmlLoad);
+    bench::report("state/binary_save", binSave, juce::String((int)binData.getSize()) + " bytes");
+    bench::report("state/binary_load", binLoad);
+
+    // Round trip must reproduce every value
+    std::vector<float> before((size_t)serializer.getNumParameters());
+    std::vector<float> after(before.size());
+    serializer.captureValues(before.data());
+    serializer.write(binData);
+    proc.randomise(rng);
+    if (!serializer.read(binData.getData(), (int)binData.getSize()))
+        bench::fail("state/binary_roundtrip", "read rejected its own output");
+    serializer.captureValues(after.data());
+    if (before != after)
+        bench::fail("state/binary_roundtrip", "values differ after reload");
+}
@@ -0,0 +1,75 @@
+#include "Bench.h"
+#include "Data/SysexCodec.h"
+#include "Data/SysexTranslator.h"
+#include <vector>
+
+// 7-bit SysEx pack/unpack: SIMD kernel vs scalar reference, plus round-trip properties
+DEEPMIND_BENCHMARK(sysex_codec)
+{
+    using data::SysexCodec;
+    juce::Random rng(7);
+
+    // --- Properties: random sizes, random bytes, short output buffers ---
+    for (int trial = 0; trial < 5000; ++trial)
+    {
+        const int size = rng.nextInt(1200);
+        std::vector<juce::uint8> raw((size_t)size);
+        for (auto& b : raw) b = (juce::uint8)rng.nextInt(256);
+
+        std::vector<juce::uint8> packed((size_t)SysexCodec::packedSizeFor(size));
+        std::vector<juce::uint8> reference(packed.size());
+        const int packedSize = SysexCodec::pack(raw.data(), size, packed.data(), (int)packed.size());
+        SysexCodec::packScalar(raw.data(), size, reference.data(), (int)reference.size());
+
+        if (packedSize != (int)packed.size() || packed != reference)
+            return bench::fail("sysex/pack", "kernel differs from scalar reference, size " + juce::String(size));
+
+        for (auto b : packed)
+            if (b & 0x80)
+                return bench::fail("sysex/pack", "output is not 7-bit clean");
+
+        // Occasionally truncate the output to exercise the capacity limit
+        const int capacity = rng.nextInt(4) == 0 ? rng.nextInt(size + 1) : size;
+        std::vector<juce::uint8> unpacked((size_t)size), unpackedRef((size_t)size);
+        const int n = SysexCodec::unpack(packed.data(), packedSize, unpacked.data(), capacity);
+        const int nRef = SysexCodec::unpackScalar(packed.data(), packedSize, unpackedRef.data(), capacity);
+
+        if (n != nRef || unpacked != unpackedRef)
+            return bench::fail("sysex/unpack", "kernel differs from scalar reference, size " + juce::String(size));
+
+        if (capacity == size && unpacked != raw)
+            return bench::fail("sysex/roundtrip", "unpack(pack(x)) != x, size " + juce::String(size));
+    }
+
+    // Program frame encoder must parse back to the same program
+    {
+        juce::uint8 program[242], decoded[data::SysexTranslator::maxProgramSize], frame[512];
+        for (auto& b : program) b = (juce::uint8)rng.nextInt(256);
+
+        int frameSize = data::SysexTranslator::buildProgramFrame(program, 242, 0, 3, 17, frame, (int)sizeof(frame));
+        int bank = 0, prog = 0;
+        int n = data::SysexTranslator::parseProgramFrame(frame, frameSize, decoded, (int)sizeof(decoded), bank, prog);
+        if (n != 242 || bank != 3 || prog != 17 || std::memcmp(program, decoded, 242) != 0)
+            bench::fail("sysex/frame_roundtrip", "parseProgramFrame(buildProgramFrame(p)) != p");
+    }
+
+    // --- Throughput on 1 MB ---
+    const int size = 1 << 20;
+    std::vector<juce::uint8> raw((size_t)size), packed((size_t)SysexCodec::packedSizeFor(size)), out((size_t)size);
+    for (auto& b : raw) b = (juce::uint8)rng.nextInt(256);
+    SysexCodec::pack(raw.data(), size, packed.data(), (int)packed.size());
+
+    auto mbps = [size](double ns) { return juce::String(size / ns * 1.0e9 / (1024.0 * 1024.0), 0) + " MB/s"; };
+    const int iterations = 50;
+
+    auto packScalar = bench::measureNs(iterations, [&] { SysexCodec::packScalar(raw.data(), size, packed.data(), (int)packed.size()); });
+    auto packSimd = bench::measureNs(iterations, [&] { SysexCodec::pack(raw.data(), size, packed.data(), (int)packed.size()); });
+    auto unpackScalar = bench::measureNs(iterations, [&] { SysexCodec::unpackScalar(packed.data(), (int)packed.size(), out.data(), size); });
+    auto unpackSimd = bench::measureNs(iterations, [&] { SysexCodec::unpack(packed.data(), (int)packed.size(), out.data(), size); });
+
+    const juce::String kernel = SysexCodec::isVectorised() ? "simd" : "scalar fallback";
+    bench::report("sysex/pack_scalar_1MB", packScalar, mbps(packScalar));
+    bench::report("sysex/pack_1MB", packSimd, mbps(packSimd) + " (" + kernel + ")");
+    bench::report("sysex/unpack_scalar_1MB", unpackScalar, mbps(unpackScalar));
+    bench::report("sysex/unpack_1MB", unpackSimd, mbps(unpackSimd) + " (" + kernel + ")");
+}
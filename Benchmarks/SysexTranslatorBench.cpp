@@ -0,0 +1,44 @@
+#include "Bench.h"
+#include "BenchProcessor.h"
+#include "Data/StateSerializer.h"
+#include "Data/SysexTranslator.h"
+#include <vector>
+
+// SysexTranslator: parsing a program dump (MidiMessage and raw frame paths) and
+// mapping the decoded program onto the parameter layout
+DEEPMIND_BENCHMARK(sysex_translator)
+{
+    using data::SysexTranslator;
+
+    BenchProcessor proc;
+    data::StateSerializer layout(proc);
+    juce::Random rng(25);
+
+    juce::uint8 program[242], decoded[SysexTranslator::maxProgramSize], frame[512];
+    for (auto& b : program) b = (juce::uint8)rng.nextInt(256);
+
+    const int frameSize = SysexTranslator::buildProgramFrame(program, 242, 0, 1, 5, frame, (int)sizeof(frame));
+    if (frameSize <= 0)
+        return bench::fail("sysex_translator/build", "buildProgramFrame failed");
+
+    const juce::MidiMessage message(frame, frameSize);
+    std::vector<float> values((size_t)layout.getNumParameters());
+
+    volatile int sink = 0;
+    int bank = 0, prog = 0;
+
+    const double parseMessage = bench::measureNs(20000, [&] { sink = sink + (int)SysexTranslator::parseSysex(message).size(); });
+    const double parseFrame = bench::measureNs(100000, [&] {
+        sink = sink + SysexTranslator::parseProgramFrame(frame, frameSize, decoded, (int)sizeof(decoded), bank, prog);
+    });
+    const double build = bench::measureNs(100000, [&] {
+        sink = sink + SysexTranslator::buildProgramFrame(program, 242, 0, 1, 5, frame, (int)sizeof(frame));
+    });
+    const double map = bench::measureNs(100000, [&] { SysexTranslator::mapProgramToParameters(decoded, 242, layout, values.data()); });
+    juce::ignoreUnused(sink);
+
+    bench::report("sysex_translator/parse_message", parseMessage, "allocating path");
+    bench::report("sysex_translator/parse_frame", parseFrame);
+    bench::report("sysex_translator/build_frame", build);
+    bench::report("sysex_translator/map_to_parameters", map, juce::String(layout.getNumParameters()) + " parameters");
+}
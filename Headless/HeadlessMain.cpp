@@ -0,0 +1,281 @@
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "RealtimeSetup.h"
+#include "DSP/TraceRecorder.h"
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+
+// DeepMindSynthHeadless: the synth as a plain audio process for rack units with no
+// display (Zynthian, Pi). ALSA/JACK audio + MIDI in, control over OSC (ports 8000/9000).
+// No editor, no window, no X connection; the message loop only runs async callbacks.
+//
+// Usage: DeepMindSynthHeadless [--type=ALSA|JACK] [--device=name] [--rate=Hz]
+//                              [--block=samples] [--midi=all|none|name] [--state=file]
+//                              [--rt-priority=1..99] [--audio-cores=2,3] [--worker-cores=0,1]
+//                              [--engine-rate=host|standard|high] [--voice-silence-db=-96]
+//                              [--osc-feedback=host[:port]]
+//                              [--no-rt] [--trace=file.json] [--list]
+//
+// --trace (tracing builds only): SIGUSR1 starts a capture, the next one writes it out
+// (file.json, then file_2.json, ...). A capture still running at exit is written too.
+
+namespace
+{
+    std::atomic<bool> quitRequested { false };
+    std::atomic<bool> traceToggleRequested { false };
+
+    void handleSignal(int) { quitRequested.store(true); }
+    void handleTraceSignal(int) { traceToggleRequested.store(true); }
+
+    // Polls the signal flags from the message thread (stopDispatchLoop and file I/O
+    // aren't signal-safe)
+    struct SignalWatcher : private juce::Timer
+    {
+        explicit SignalWatcher(const juce::File& trace) : traceFile(trace) { startTimer(100); }
+
+        void timerCallback() override
+        {
+            if (traceToggleRequested.exchange(false))
+                toggleTrace();
+
+            if (quitRequested.load())
+                juce::MessageManager::getInstance()->stopDispatchLoop();
+        }
+
+        void toggleTrace()
+        {
+#if DEEPMIND_TRACING
+            auto& recorder = DeepMindDSP::TraceRecorder::getInstance();
+            if (recorder.isRecording())
+            {
+                recorder.stop();
+                std::printf("Trace written (%d events dropped)\n", recorder.getDroppedEvents());
+                return;
+            }
+
+            if (traceFile == juce::File()) return;
+
+            auto file = captures++ == 0 ? traceFile
+                                        : traceFile.getSiblingFile(traceFile.getFileNameWithoutExtension() + "_" + juce::String(captures)
+                                                                   + traceFile.getFileExtension());
+            if (recorder.start(file))
+                std::printf("Tracing to %s\n", file.getFullPathName().toRawUTF8());
+#endif
+        }
+
+        juce::File traceFile;
+        int captures = 0;
+    };
+
+    // Sits between the device and the player: prefaults the engine after each
+    // prepareToPlay, and applies the real-time setup on the first callback's thread
+    class RealtimeCallback : public juce::AudioIODeviceCallback
+    {
+    public:
+        RealtimeCallback(juce::AudioProcessorPlayer& p, DeepMindSynthAudioProcessor& proc, headless::RealtimeSetup& rt)
+            : player(p), processor(proc), realtime(rt) {}
+
+        void audioDeviceAboutToStart(juce::AudioIODevice* device) override
+        {
+            player.audioDeviceAboutToStart(device); // prepareToPlay
+            processor.prefaultBuffers();
+            realtime.markEnginePrefaulted();
+        }
+
+        void audioDeviceIOCallbackWithContext(const float* const* inputs, int numInputs,
+                                              float* const* outputs, int numOutputs, int numSamples,
+                                              const juce::AudioIODeviceCallbackContext& context) override
+        {
+            if (!realtime.isAudioThreadConfigured())
+            {
+                realtime.configureAudioThread();
+                DEEPMIND_TRACE_THREAD("Audio");
+            }
+
+            player.audioDeviceIOCallbackWithContext(inputs, numInputs, outputs, numOutputs, numSamples, context);
+        }
+
+        void audioDeviceStopped() override { player.audioDeviceStopped(); }
+
+    private:
+        juce::AudioProcessorPlayer& player;
+        DeepMindSynthAudioProcessor& processor;
+        headless::RealtimeSetup& realtime;
+    };
+
+    void listDevices(juce::AudioDeviceManager& deviceManager)
+    {
+        for (auto* type : deviceManager.getAvailableDeviceTypes())
+        {
+            type->scanForDevices();
+            std::printf("%s\n", type->getTypeName().toRawUTF8());
+            for (auto& name : type->getDeviceNames())
+                std::printf("    %s\n", name.toRawUTF8());
+        }
+
+        std::printf("MIDI inputs\n");
+        for (auto& device : juce::MidiInput::getAvailableDevices())
+            std::printf("    %s\n", device.name.toRawUTF8());
+    }
+
+    juce::String openAudio(juce::AudioDeviceManager& deviceManager, const juce::ArgumentList& args)
+    {
+        if (args.containsOption("--type"))
+            deviceManager.setCurrentAudioDeviceType(args.getValueForOption("--type"), true);
+
+        // Stereo in for the Ext Input FX path, stereo out
+        auto error = deviceManager.initialiseWithDefaultDevices(2, 2);
+        if (error.isNotEmpty()) return error;
+
+        auto setup = deviceManager.getAudioDeviceSetup();
+        if (args.containsOption("--device"))
+            setup.outputDeviceName = setup.inputDeviceName = args.getValueForOption("--device");
+        if (args.containsOption("--rate"))
+            setup.sampleRate = args.getValueForOption("--rate").getDoubleValue();
+        if (args.containsOption("--block"))
+            setup.bufferSize = args.getValueForOption("--block").getIntValue();
+
+        return deviceManager.setAudioDeviceSetup(setup, true);
+    }
+
+    void openMidi(juce::AudioDeviceManager& deviceManager, juce::MidiInputCallback& callback, const juce::String& selection)
+    {
+        if (selection == "none") return;
+
+        for (auto& device : juce::MidiInput::getAvailableDevices())
+        {
+            if (selection != "all" && !device.name.containsIgnoreCase(selection))
+                continue;
+
+            deviceManager.setMidiInputDeviceEnabled(device.identifier, true);
+            std::printf("MIDI in: %s\n", device.name.toRawUTF8());
+        }
+
+        deviceManager.addMidiInputDeviceCallback({}, &callback); // All enabled inputs
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    // MessageManager for async callbacks (polyphony changes, parameter listeners).
+    // On Linux this is a plain event loop; no display is opened unless a window is made.
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::AudioDeviceManager deviceManager;
+
+    if (args.containsOption("--list"))
+    {
+        listDevices(deviceManager);
+        return 0;
+    }
+
+    // Before anything allocates engine buffers or starts threads (see RealtimeSetup)
+    headless::RealtimeSetup::Options rtOptions;
+    rtOptions.enabled = !args.containsOption("--no-rt");
+    if (args.containsOption("--rt-priority"))
+        rtOptions.priority = args.getValueForOption("--rt-priority").getIntValue();
+    rtOptions.audioCores = headless::RealtimeSetup::parseCores(args.getValueForOption("--audio-cores"));
+    rtOptions.workerCores = headless::RealtimeSetup::parseCores(args.getValueForOption("--worker-cores"));
+
+    headless::RealtimeSetup realtime(rtOptions);
+    realtime.configureProcess();
+
+#if DEEPMIND_TRACING
+    DeepMindDSP::TraceRecorder::getInstance(); // Rings allocated here, not on the audio thread
+#endif
+
+    auto processor = std::make_unique<DeepMindSynthAudioProcessor>();
+
+    // Saved state: loaded at start, written back on a clean exit
+    juce::File stateFile;
+    if (args.containsOption("--state"))
+    {
+        stateFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--state"));
+
+        juce::MemoryBlock state;
+        if (stateFile.existsAsFile() && stateFile.loadFileAsData(state))
+            processor->setStateInformation(state.getData(), (int)state.getSize());
+    }
+
+    // After --state, so the flag wins over the saved choice
+    if (args.containsOption("--engine-rate"))
+    {
+        const auto rate = args.getValueForOption("--engine-rate").toLowerCase();
+        processor->setEngineRate(rate == "high"     ? DeepMindSynthAudioProcessor::EngineRate::High
+                                 : rate == "standard" ? DeepMindSynthAudioProcessor::EngineRate::Standard
+                                                      : DeepMindSynthAudioProcessor::EngineRate::Host);
+    }
+
+    // Release tails below this level are cut (lower = longer tails, more voices busy)
+    if (args.containsOption("--voice-silence-db"))
+        processor->setVoiceSilenceThreshold(args.getValueForOption("--voice-silence-db").getFloatValue(), 0.05);
+
+    // OSC feedback to a controller elsewhere on the network (default 127.0.0.1:9000)
+    if (args.containsOption("--osc-feedback"))
+    {
+        auto target = args.getValueForOption("--osc-feedback");
+        auto port = target.containsChar(':') ? target.fromLastOccurrenceOf(":", false, false).getIntValue()
+                                             : DeepMindSynthAudioProcessor::defaultOscFeedbackPort;
+        processor->setOscFeedbackTarget(target.upToLastOccurrenceOf(":", false, false), port);
+    }
+
+    auto error = openAudio(deviceManager, args);
+    if (error.isNotEmpty())
+    {
+        std::fprintf(stderr, "Audio device error: %s\n", error.toRawUTF8());
+        return 1;
+    }
+
+    juce::AudioProcessorPlayer player;
+    player.setProcessor(processor.get());
+    RealtimeCallback callback(player, *processor, realtime);
+    deviceManager.addAudioCallback(&callback);
+
+    openMidi(deviceManager, player, args.containsOption("--midi") ? args.getValueForOption("--midi") : juce::String("all"));
+
+    if (auto* device = deviceManager.getCurrentAudioDevice())
+        std::printf("Audio: %s (%s) %.0f Hz, %d samples\n",
+                    device->getName().toRawUTF8(), device->getTypeName().toRawUTF8(),
+                    device->getCurrentSampleRate(), device->getCurrentBufferSizeSamples());
+
+    // The audio-thread half of the setup happens on the first callback
+    for (int waited = 0; waited < 2000 && !realtime.isAudioThreadConfigured(); waited += 10)
+        juce::Thread::sleep(10);
+
+    for (auto& line : realtime.getReport())
+        std::printf("RT  %s\n", line.toRawUTF8());
+
+    juce::File traceFile;
+    if (args.containsOption("--trace"))
+        traceFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--trace"));
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    std::signal(SIGUSR1, handleTraceSignal);
+
+    {
+        SignalWatcher watcher(traceFile);
+        juce::MessageManager::getInstance()->runDispatchLoop();
+    }
+
+#if DEEPMIND_TRACING
+    DeepMindDSP::TraceRecorder::getInstance().stop();
+#endif
+
+    deviceManager.removeMidiInputDeviceCallback({}, &player);
+    deviceManager.removeAudioCallback(&callback);
+    deviceManager.closeAudioDevice();
+    player.setProcessor(nullptr);
+
+    if (stateFile != juce::File())
+    {
+        juce::MemoryBlock state;
+        processor->getStateInformation(state);
+        stateFile.replaceWithData(state.getData(), state.getSize());
+    }
+
+    return 0;
+}
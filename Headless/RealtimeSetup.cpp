@@ -0,0 +1,152 @@
+#include "RealtimeSetup.h"
+#include <cerrno>
+#include <cstring>
+
+#if JUCE_LINUX
+ #include <alloca.h>
+ #include <malloc.h>
+ #include <pthread.h>
+ #include <sched.h>
+ #include <sys/mman.h>
+#endif
+
+namespace headless
+{
+    namespace
+    {
+#if JUCE_LINUX
+        int pinThread(pthread_t thread, const juce::Array<int>& cores)
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int core : cores)
+                if (core >= 0 && core < CPU_SETSIZE)
+                    CPU_SET(core, &set);
+
+            return pthread_setaffinity_np(thread, sizeof(set), &set); // Returns the error, not errno
+        }
+
+        juce::Array<int> getThreadCores(pthread_t thread)
+        {
+            juce::Array<int> cores;
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (pthread_getaffinity_np(thread, sizeof(set), &set) == 0)
+                for (int core = 0; core < CPU_SETSIZE; ++core)
+                    if (CPU_ISSET(core, &set))
+                        cores.add(core);
+            return cores;
+        }
+
+        // Writes one byte per page of the callback's stack so its deepest frames are
+        // already mapped. Not inlined, so the array really is on this thread's stack.
+        __attribute__((noinline)) void touchStack(int bytes)
+        {
+            volatile char* stack = static_cast<volatile char*>(alloca((size_t)bytes));
+            for (int i = 0; i < bytes; i += 4096)
+                stack[i] = 0;
+        }
+#endif
+
+        juce::String describe(const juce::String& step, int result, const juce::String& hint = {})
+        {
+            juce::String line = step.paddedRight('.', 28) + " ";
+            if (result == 0) return line + "ok";
+            if (result < 0) return line + "skipped";
+            return line + "failed (" + std::strerror(result) + ")" + (hint.isNotEmpty() ? " - " + hint : juce::String());
+        }
+    }
+
+    RealtimeSetup::RealtimeSetup(const Options& o) : options(o) {}
+
+    juce::Array<int> RealtimeSetup::parseCores(const juce::String& list)
+    {
+        juce::Array<int> cores;
+        for (auto& token : juce::StringArray::fromTokens(list, ",", {}))
+            if (token.trim().containsOnly("0123456789") && token.trim().isNotEmpty())
+                cores.addIfNotAlreadyThere(token.trim().getIntValue());
+        return cores;
+    }
+
+    void RealtimeSetup::configureProcess()
+    {
+        if (!options.enabled) return;
+
+#if JUCE_LINUX
+        // Everything mapped now and later stays in RAM (later = prepareToPlay's buffers)
+        memoryLockResult = mlockall(MCL_CURRENT | MCL_FUTURE) == 0 ? 0 : errno;
+
+  #if defined(__GLIBC__)
+        // Freed memory stays in the (locked) heap instead of going back to the kernel,
+        // and large blocks come from the heap too, so a later malloc can't fault
+        heapResult = (mallopt(M_TRIM_THRESHOLD, -1) == 1 && mallopt(M_MMAP_MAX, 0) == 1) ? 0 : EINVAL;
+  #endif
+
+        if (!options.workerCores.isEmpty())
+        {
+            processCores = getThreadCores(pthread_self());
+            workerAffinityResult = pinThread(pthread_self(), options.workerCores);
+        }
+#endif
+    }
+
+    void RealtimeSetup::configureAudioThread()
+    {
+        if (audioThreadDone.load()) return;
+        if (!options.enabled)
+        {
+            audioThreadDone.store(true);
+            return;
+        }
+
+#if JUCE_LINUX
+        sched_param param {};
+        param.sched_priority = juce::jlimit(sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO), options.priority);
+        schedulerResult.store(pthread_setschedparam(pthread_self(), SCHED_FIFO, &param));
+
+        // Without audio cores, undo the worker pinning this thread inherited
+        if (!options.audioCores.isEmpty())
+            audioAffinityResult.store(pinThread(pthread_self(), options.audioCores));
+        else if (!processCores.isEmpty())
+            audioAffinityResult.store(pinThread(pthread_self(), processCores));
+
+        touchStack(stackPrefaultBytes);
+        stackPrefaulted.store(true);
+#endif
+
+        audioThreadDone.store(true);
+    }
+
+    juce::StringArray RealtimeSetup::getReport() const
+    {
+        juce::StringArray report;
+
+        auto coreList = [](const juce::Array<int>& cores) {
+            juce::StringArray names;
+            for (int core : cores) names.add(juce::String(core));
+            return names.joinIntoString(",");
+        };
+
+#if JUCE_LINUX
+        if (options.enabled)
+        {
+            report.add(describe("mlockall", memoryLockResult, "raise 'memlock' in /etc/security/limits.conf"));
+            report.add(describe("heap trim/mmap off", heapResult));
+            report.add(describe("SCHED_FIFO " + juce::String(options.priority), schedulerResult.load(),
+                                "raise 'rtprio' in limits.conf or run with CAP_SYS_NICE"));
+            report.add(describe("audio cores " + coreList(options.audioCores.isEmpty() ? processCores : options.audioCores),
+                                audioAffinityResult.load()));
+            report.add(describe("worker cores " + coreList(options.workerCores), workerAffinityResult));
+            report.add(describe("audio stack prefault", stackPrefaulted.load() ? 0 : notRun));
+        }
+        else
+        {
+            report.add("Real-time scheduling and memory locking disabled");
+        }
+#else
+        report.add("Real-time setup is only implemented on Linux");
+#endif
+        report.add(describe("engine buffers prefaulted", enginePrefaulted.load() ? 0 : notRun));
+        return report;
+    }
+}
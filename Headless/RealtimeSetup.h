@@ -0,0 +1,61 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+
+namespace headless
+{
+    // Real-time setup for the headless process (Linux; a no-op elsewhere).
+    //
+    // configureProcess() runs on the main thread before the processor and the audio
+    // device exist: mlockall(current + future) so every buffer allocated afterwards
+    // is resident, stop malloc handing memory back to the kernel, and pin the main
+    // thread to the worker cores (OSC, feedback and preset threads inherit that).
+    // configureAudioThread() runs once, from the first audio callback: SCHED_FIFO,
+    // pin to the audio cores and prefault the callback's stack. The audio thread is
+    // started from the main thread and inherits the worker cores, so without audio
+    // cores it gets the process's original CPU set back instead.
+    //
+    // Nothing here is fatal; each step's outcome goes into getReport().
+    class RealtimeSetup
+    {
+    public:
+        struct Options
+        {
+            bool enabled = true;
+            int priority = 70;            // SCHED_FIFO, 1..99
+            juce::Array<int> audioCores;  // Empty = any core the process could use at start
+            juce::Array<int> workerCores;
+        };
+
+        explicit RealtimeSetup(const Options& options);
+
+        void configureProcess();
+        void configureAudioThread(); // Audio thread, once
+
+        // The processor's prefaultBuffers() ran (reported alongside the rest)
+        void markEnginePrefaulted() { enginePrefaulted.store(true); }
+
+        bool isAudioThreadConfigured() const { return audioThreadDone.load(); }
+        juce::StringArray getReport() const;
+
+        // "2,3" -> {2, 3}
+        static juce::Array<int> parseCores(const juce::String& list);
+
+    private:
+        static constexpr int notRun = -1;
+        static constexpr int stackPrefaultBytes = 256 * 1024;
+
+        Options options;
+        juce::Array<int> processCores; // Affinity before the worker pinning
+
+        // errno of each step (0 = ok, notRun = skipped)
+        int memoryLockResult = notRun;
+        int heapResult = notRun;
+        int workerAffinityResult = notRun;
+        std::atomic<int> schedulerResult { notRun };
+        std::atomic<int> audioAffinityResult { notRun };
+        std::atomic<bool> stackPrefaulted { false };
+        std::atomic<bool> audioThreadDone { false };
+        std::atomic<bool> enginePrefaulted { false };
+    };
+}
@@ -0,0 +1,107 @@
+#include "DriftBank.h"
+#include <atomic>
+#include <cmath>
+
+using namespace DeepMindDSP;
+
+namespace
+{
+    // splitmix32: spreads consecutive instance numbers into unrelated seeds
+    juce::uint32 mixSeed(juce::uint32 x)
+    {
+        x += 0x9E3779B9u;
+        x = (x ^ (x >> 16)) * 0x85EBCA6Bu;
+        x = (x ^ (x >> 13)) * 0xC2B2AE35u;
+        return x ^ (x >> 16);
+    }
+}
+
+DriftBank::DriftBank()
+{
+    static std::atomic<juce::uint32> instanceCounter { 0 };
+    juce::uint32 base = mixSeed(instanceCounter.fetch_add(1)) * (juce::uint32)NumLanes;
+
+    for (int i = 0; i < NumLanes; ++i)
+        rng[i] = mixSeed(base + (juce::uint32)i) | 1u; // xorshift must not start at 0
+
+    reset();
+}
+
+void DriftBank::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    coeffDirty = true;
+}
+
+void DriftBank::setRate(float hz)
+{
+    const float newRate = juce::jmax(0.01f, hz);
+    if (newRate != rateHz)
+    {
+        rateHz = newRate;
+        coeffDirty = true;
+    }
+}
+
+void DriftBank::reset()
+{
+    for (int i = 0; i < NumLanes; ++i)
+        stage1[i] = stage2[i] = output[i] = 0.0f;
+    pendingSamples = 0;
+}
+
+void DriftBank::updateCoefficient()
+{
+    // One-pole step for a whole control interval at once (drift is control rate)
+    coeffDirty = false;
+    coeff = 1.0f - (float)std::exp(-juce::MathConstants<double>::twoPi * rateHz * ControlInterval / sampleRate);
+
+    // Power gain of two identical one-poles: a^4 (1 + b^2) / (1 - b^2)^3, b = 1 - a.
+    // Undo it so the output keeps the noise's spread (std dev ~0.58) at any rate.
+    const double a = coeff, b = 1.0 - a;
+    const double powerGain = a * a * a * a * (1.0 + b * b) / std::pow(1.0 - b * b, 3.0);
+    normGain = (float)(1.0 / std::sqrt(juce::jmax(1.0e-12, powerGain)));
+}
+
+const float* DriftBank::process(int numSamples)
+{
+    if (coeffDirty)
+        updateCoefficient();
+
+    pendingSamples += juce::jmax(0, numSamples);
+    const int steps = pendingSamples / ControlInterval;
+    if (steps == 0)
+        return output; // Short sub-block: the held values are still current
+
+    pendingSamples -= steps * ControlInterval;
+
+    const float a = coeff;
+    const float gain = normGain;
+
+    for (int step = 0; step < steps; ++step)
+    {
+        // xorshift32, all lanes
+        for (int i = 0; i < NumLanes; ++i)
+        {
+            juce::uint32 x = rng[i];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            rng[i] = x;
+        }
+
+        // Noise -> two one-poles
+        for (int i = 0; i < NumLanes; ++i)
+        {
+            float noise = (float)(juce::int32)rng[i] * (1.0f / 2147483648.0f);
+            stage1[i] += a * (noise - stage1[i]);
+            stage2[i] += a * (stage1[i] - stage2[i]);
+        }
+    }
+
+    // Normalised, clipped output
+    for (int i = 0; i < NumLanes; ++i)
+        output[i] = juce::jlimit(-1.0f, 1.0f, stage2[i] * gain);
+
+    return output;
+}
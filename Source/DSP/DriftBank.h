@@ -0,0 +1,49 @@
+#pragma once
+#include <JuceHeader.h>
+
+namespace DeepMindDSP
+{
+    // Analog drift for a whole voice: one independent slow random signal per oscillator
+    // (both DCOs of every unison layer) and one for the filter.
+    // Each lane is xorshift noise through two one-pole lowpasses, stepped once every
+    // ControlInterval samples however the render calls split the block (so the
+    // coefficient only changes with the rate or sample rate). The lanes live in plain arrays and every step is a straight loop
+    // over all of them with no branches, so the compiler runs them as SIMD
+    // (4 lanes per SSE/NEON op). All 32 lanes cost about as much as a few scalar generators.
+    class DriftBank
+    {
+    public:
+        static constexpr int NumLanes = 32;  // Multiple of the SIMD width
+        static constexpr int Osc1Lane = 0;   // + unison layer (0..11)
+        static constexpr int Osc2Lane = 12;  // + unison layer (0..11)
+        static constexpr int FilterLane = 24;
+        static constexpr int ControlInterval = 64; // Samples per lane step
+
+        DriftBank(); // Seeds differ per instance, so voices never drift in step
+
+        void prepare(double sampleRate);
+        void reset();
+        void setRate(float hz); // Lowpass corner (default 0.5 Hz)
+
+        // Advance all lanes by numSamples (whole control steps; the remainder carries
+        // over to the next call). Returns NumLanes values, roughly -1..1.
+        const float* process(int numSamples);
+        const float* getValues() const { return output; }
+
+    private:
+        void updateCoefficient();
+
+        double sampleRate = 44100.0;
+        float rateHz = 0.5f;
+
+        bool coeffDirty = true;
+        int pendingSamples = 0; // Not yet a whole control step
+        float coeff = 0.0f;
+        float normGain = 1.0f;
+
+        alignas(16) juce::uint32 rng[NumLanes];
+        alignas(16) float stage1[NumLanes];
+        alignas(16) float stage2[NumLanes];
+        alignas(16) float output[NumLanes];
+    };
+}
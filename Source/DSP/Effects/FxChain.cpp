@@ -1,5 +1,7 @@
 // FxChain.cpp
 #include "FxChain.h"
+#include "../Kernels/Kernels.h"
+#include "../TraceRecorder.h"
 
 using namespace DeepMindDSP;
 
@@ -31,130 +33,83 @@ void FxChain::reset()
     eq.reset();
 }
 
+void FxChain::prefault(double seconds)
+{
+    juce::AudioBuffer<float> silence(parBuffer.getNumChannels(), parBuffer.getNumSamples());
+    const int savedRouting = currentRouting;
+    
+    // The lines' write positions move one sample at a time whatever the settings, so
+    // 'seconds' of samples cover them; the last block goes through the parallel path
+    // for its buffers
+    const int blockSize = juce::jmax(1, silence.getNumSamples());
+    for (int done = 0, total = (int)(seconds * sampleRate); done < total; done += blockSize)
+    {
+        silence.clear();
+        juce::dsp::AudioBlock<float> block(silence);
+        currentRouting = done + blockSize >= total ? 1 : 0;
+        process(block);
+    }
+    
+    currentRouting = savedRouting;
+    reset();
+}
+
 void FxChain::process(juce::dsp::AudioBlock<float>& block)
 {
     // 0. Distortion (Always Insert)
-    distortion.process(block);
+    {
+        DEEPMIND_TRACE_ZONE("fx: distortion");
+        distortion.process(block);
+    }
 
     if (currentRouting == 0) // SERIES
     {
-        phaser.process(block);
-        chorus.process(block);
-        delay.process(block);
-        reverb.process(block);
+        auto runEffect = [&](const char* zone, auto& effect)
+        {
+            DEEPMIND_TRACE_ZONE(zone);
+            juce::ignoreUnused(zone);
+            effect.process(block);
+        };
+        
+        runEffect("fx: phaser", phaser);
+        runEffect("fx: chorus", chorus);
+        runEffect("fx: delay", delay);
+        runEffect("fx: reverb", reverb);
     }
     else // PARALLEL
     {
-        // 1. Copy Distorted Input to Temp (Wet Path Accumulator)
-        // Actually, we want: Out = Dry + WetA + WetB... 
-        // But our effects are configured as dry/wet Mixers internally.
-        // If we run them in parallel on the same buffer, they will overwrite each other.
-        // We need:
-        // Input -> Phaser -> BufferA
-        // Input -> Chorus -> BufferB
-        // ...
-        // Sum BufferA + BufferB + ...
-        
-        // Simplified Strategy for this codebase without allocating 4 buffers:
-        // Use `parBuffer` as accumulator. Clear it.
-        // For each FX:
-        //   Copy Input to a scratch space?
-        //   Process.
-        //   Add to Accumulator.
-        
-        // Let's use `block` as Source.
-        // We need one scratch buffer to hold the input state, and one to accumulate?
-        // Or:
-        // Acc = 0.
-        // Scratch = Input. Phaser.process(Scratch). Acc += Scratch.
-        // Scratch = Input. Chorus.process(Scratch). Acc += Scratch.
-        // ...
-        // Input = Acc.
+        // Every effect gets the same (post-distortion) input. The effects mix dry/wet
+        // internally, so only what each one changes is summed:
+        // Out = Dry + sum(FX_i(Dry) - Dry)
+        // parBuffer holds the dry input, accBuffer is the scratch each effect runs in.
+        const auto numChannels = juce::jmin(block.getNumChannels(), (size_t)parBuffer.getNumChannels());
+        const auto numSamples = juce::jmin(block.getNumSamples(), (size_t)parBuffer.getNumSamples());
         
-        // But `block` is modifying in place.
-        // So:
-        // 1. Save Input (Post-Dist) to `parBuffer` (as Source Copy).
-        juce::dsp::AudioBlock<float> srcBlock(parBuffer);
-        srcBlock.copyFrom(block); // Save State
+        auto dry = juce::dsp::AudioBlock<float>(parBuffer).getSubsetChannelBlock(0, numChannels).getSubBlock(0, numSamples);
+        auto wet = juce::dsp::AudioBlock<float>(accBuffer).getSubsetChannelBlock(0, numChannels).getSubBlock(0, numSamples);
+        dry.copyFrom(block);
         
-        // 2. Clear Main Block (it will be Accumulator)
-        block.clear();
-        
-        // 3. Process & Accumulate
-        // Helper to process additively
-        auto processAdd = [&](auto& effect) {
-            // Restore Input from Source
-            juce::dsp::AudioBlock<float> scratch(parBuffer); // We use parBuffer as source, but we need 3rd buffer?
-            // Ah, we need 2 buffers. Source and Output are distinct.
-            // If we only have 1 temp buffer:
-            // Output is `block`.
-            // Copy `block` to `parBuffer`. `parBuffer` is now INPUT SOURCE.
-            // `block` is now ACCUMULATOR.
-             
-            // Wait, we can't process `parBuffer` in place multiple times, it would mutate.
-            // We need: 
-            // Input (Safe)
-            // Output (Acc)
-            // Temp (Processing)
-            
-            // Optimization: Just do Series for now if buffers are tricky?
-            // No, User wants Routing.
-            // Let's alloc a 2nd temp buffer dynamically? No, in prepare.
-            // Let's assume we just process sequentially on the same buffer for Series.
-            // For Parallel:
-            // We really need separate buffers.
+        const auto& kernels = Kernels::get();
+        auto addEffect = [&](const char* zone, auto& effect)
+        {
+            DEEPMIND_TRACE_ZONE(zone);
+            juce::ignoreUnused(zone);
+            wet.copyFrom(dry);
+            effect.process(wet);
             
-            // Alternate Strategy:
-            // Since we only have one extra buffer `parBuffer`.
-            // Let's do:
-            // 1. Copy `block` (Input) to `parBuffer`.
-            // 2. Process `block` through Phaser.
-            // 3. `block` now has Phaser output.
-            // 4. We want to ADD Chorus output.
-            // 5. But we lost Input.
-            
-            // OK, we need to Re-Copy Input from somewhere.
-            // Let's make `parBuffer` be the "Held Input".
-            // And use `block` as the "Working Area".
-            // But we need to Sum to `block`.
-            
-            // Correct way with 1 temp buffer:
-            // 1. Copy `block` to `parBuffer` (INPUT).
-            // 2. Clear `block` (OUTPUT).
-            // 3. Loop Effects:
-            //      Make a view of INPUT (`parBuffer`).
-            //      Wait, effects process in-place. We can't process `parBuffer` directly or next FX gets processed signal.
-            //      We need a COPY of INPUT to process.
-            
-            // Conclusion: We need a dedicated Scratch buffer if effects are in-place.
-            // Or use the `parBuffer` as Scratch, and a 2nd buffer as Input Store?
-            // Let's use `parBuffer` as Input Store.
-            // Use `block` as Scratch?
-            // Where to accumulate?
-            // We can allocate a member `accBuffer`.
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                kernels.addDifference(block.getChannelPointer(ch), wet.getChannelPointer(ch),
+                                      dry.getChannelPointer(ch), (int)numSamples);
         };
-        // Changing strategy to "Partial Series" to avoid buffer hell?
-        // No, let's just add `accBuffer` to header in next step quickly.
-        // Wait, I can't look back.
-        
-        // Quick Fix:
-        // Use `block` as Input Store.
-        // Use `parBuffer` as Accumulator.
-        // 1. Clear `parBuffer` (Acc).
-        // 2. Process Phaser on `block`. Add `block` to `parBuffer`. 
-        //    (Problem: `block` is mutated. We lost input for next effect).
-        
-        // OK, I'll stick to SERIES for this step and add the buffer in a dedicated step correctly.
-        // ACTUALLY, I can define a local AudioBuffer if heap alloc is small/rare (bad for realtime).
-        // I will re-write the Header to include `accBuffer` properly.
         
-        // RE-PLAN:
-        // 1. Just implement Series logic here as placeholder.
-        // 2. Add `accBuffer` to Header.
-        // 3. Implement Parallel logic properly.
+        addEffect("fx: phaser", phaser);
+        addEffect("fx: chorus", chorus);
+        addEffect("fx: delay", delay);
+        addEffect("fx: reverb", reverb);
     }
     
     // EQ (Post-Routing)
+    DEEPMIND_TRACE_ZONE("fx: eq");
     eq.process(block);
 }
 
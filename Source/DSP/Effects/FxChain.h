@@ -15,6 +15,11 @@ namespace DeepMindDSP
         void prepare(const juce::dsp::ProcessSpec& spec);
         void reset();
         
+        // Runs silence through both routings for 'seconds' (at least the longest delay)
+        // so every delay and reverb line has been written end to end, then resets.
+        // Not the audio thread; after prepare.
+        void prefault(double seconds);
+        
         void process(juce::dsp::AudioBlock<float>& block);
         
         // Effect parameters
@@ -0,0 +1,50 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cstring>
+
+namespace DeepMindDSP
+{
+    // Fast exponentials for pitch work (replaces std::pow(2.0f, x) in the voice path).
+    //
+    // exp2: x = n + f with n = round(x), f in [-0.5, 0.5). 2^n goes straight into the
+    // float exponent bits, 2^f is a degree-5 polynomial. Max error ~3.6e-6 relative
+    // (0.006 cent), well under the 0.1 cent we can hear. Branch-free, so the array
+    // versions vectorise across unison layers.
+    namespace FastMath
+    {
+        inline float exp2(float x)
+        {
+            x = juce::jlimit(-126.0f, 126.0f, x);
+
+            // Round to nearest without a libm call (x + 128.5 > 0, so truncation == floor)
+            const int n = (int)(x + 128.5f) - 128;
+            const float f = x - (float)n;
+
+            const float p = 1.0f + f * (0.693147181f + f * (0.240226507f + f * (0.0555041087f
+                                  + f * (0.00961812911f + f * 0.00133335581f))));
+
+            const juce::int32 bits = (juce::int32)(n + 127) << 23;
+            float scale;
+            std::memcpy(&scale, &bits, sizeof(scale));
+            return p * scale;
+        }
+
+        inline float semitonesToRatio(float semitones)
+        {
+            return exp2(semitones * (1.0f / 12.0f));
+        }
+
+        // Array versions (e.g. every unison layer at once)
+        inline void exp2(const float* x, float* result, int num)
+        {
+            for (int i = 0; i < num; ++i)
+                result[i] = exp2(x[i]);
+        }
+
+        inline void semitonesToRatio(const float* semitones, float* ratios, int num)
+        {
+            for (int i = 0; i < num; ++i)
+                ratios[i] = exp2(semitones[i] * (1.0f / 12.0f));
+        }
+    }
+}
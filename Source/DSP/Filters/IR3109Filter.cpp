@@ -0,0 +1,158 @@
+#include "IR3109Filter.h"
+
+using namespace DeepMindDSP;
+
+namespace
+{
+    using SIMDFloat = juce::dsp::SIMDRegister<float>;
+
+    // Apply a scalar function to every lane (coefficient updates only, never per sample)
+    template <typename Fn>
+    float forEachLane(float x, Fn&& fn) { return fn(x); }
+
+    template <typename Fn>
+    SIMDFloat forEachLane(SIMDFloat x, Fn&& fn)
+    {
+        for (size_t i = 0; i < SIMDFloat::size(); ++i)
+            x.set(i, fn(x.get(i)));
+        return x;
+    }
+
+    float clampAbs(float x, float limit) { return juce::jlimit(-limit, limit, x); }
+
+    SIMDFloat clampAbs(SIMDFloat x, float limit)
+    {
+        return SIMDFloat::min(SIMDFloat::max(x, SIMDFloat::expand(-limit)), SIMDFloat::expand(limit));
+    }
+
+    // OTA saturation: clipped cubic. Only min/max/mul/add so it vectorizes.
+    // Smooth (zero slope) at +/-1.5 where the output reaches +/-1.
+    template <typename T>
+    T softClip(T x)
+    {
+        x = clampAbs(x, 1.5f);
+        return x * (T(1.0f) - x * x * (4.0f / 27.0f));
+    }
+}
+
+template <typename SampleType>
+IR3109Filter<SampleType>::IR3109Filter()
+{
+    reset();
+}
+
+template <typename SampleType>
+void IR3109Filter<SampleType>::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    reset();
+    updateCoefficients();
+}
+
+template <typename SampleType>
+void IR3109Filter<SampleType>::reset()
+{
+    for (auto& state : s)
+        state = SampleType(0.0f);
+}
+
+template <typename SampleType>
+void IR3109Filter<SampleType>::setCutoff(SampleType frequency)
+{
+    cutoff = frequency;
+    updateCoefficients();
+}
+
+template <typename SampleType>
+void IR3109Filter<SampleType>::setResonance(SampleType newResonance)
+{
+    resonance = newResonance;
+    updateCoefficients();
+}
+
+template <typename SampleType>
+void IR3109Filter<SampleType>::setTwoPole(bool shouldUseTwoPoles)
+{
+    if (twoPole == shouldUseTwoPoles) return;
+    twoPole = shouldUseTwoPoles;
+    updateCoefficients();
+}
+
+template <typename SampleType>
+void IR3109Filter<SampleType>::setDrive(NumericType newDrive)
+{
+    drive = juce::jmax((NumericType) 0.1, newDrive);
+}
+
+template <typename SampleType>
+void IR3109Filter<SampleType>::updateCoefficients()
+{
+    // Prewarped integrator gain, one tan() per lane per update (block rate)
+    const auto nyquistLimit = (float)(sampleRate * 0.45);
+    const auto piOverFs = (float)(juce::MathConstants<double>::pi / sampleRate);
+
+    SampleType g = forEachLane(cutoff, [&](float fc) {
+        return std::tan(juce::jlimit(20.0f, nyquistLimit, fc) * piOverFs);
+    });
+
+    oneMinusG = forEachLane(g, [](float x) { return 1.0f / (1.0f + x); });
+    G = g * oneMinusG;
+
+    // Resonance: 4-pole loop oscillates at k = 4, 2-pole never does (DeepMind behaviour)
+    const float maxK = twoPole ? 2.0f : 4.2f;
+    k = forEachLane(resonance, [&](float r) { return juce::jlimit(0.0f, 1.0f, r) * maxK; });
+
+    SampleType gN = twoPole ? (G * G) : (G * G * G * G);
+    loopNorm = forEachLane(k * gN + SampleType(1.0f), [](float x) { return 1.0f / x; });
+
+    // The IR3109 loses some bass as Q rises; only half-compensate to keep that character
+    inputGain = k * 0.5f + SampleType(1.0f);
+}
+
+template <typename SampleType>
+void IR3109Filter<SampleType>::process(SampleType* samples, size_t numSamples)
+{
+    // Pole count is hoisted out of the sample loop
+    if (twoPole)
+        processPoles<2>(samples, numSamples);
+    else
+        processPoles<4>(samples, numSamples);
+}
+
+template <typename SampleType>
+template <int NumPoles>
+void IR3109Filter<SampleType>::processPoles(SampleType* samples, size_t numSamples)
+{
+    const NumericType invDrive = (NumericType) 1.0 / drive;
+
+    for (size_t n = 0; n < numSamples; ++n)
+    {
+        // Each TPT stage is y = G*x + s/(1+g). Fold the states into the
+        // loop output estimate: y_N = G^N * u + S.
+        SampleType S = s[0] * oneMinusG;
+        for (int i = 1; i < NumPoles; ++i)
+            S = S * G + s[i] * oneMinusG;
+
+        // Linear loop solution, then OTA saturation on the loop input
+        SampleType u = (samples[n] * inputGain - k * S) * loopNorm;
+        u = softClip(u * drive) * invDrive;
+
+        // Run the cascade
+        SampleType x = u;
+        for (int i = 0; i < NumPoles; ++i)
+        {
+            SampleType v = (x - s[i]) * G;
+            SampleType y = v + s[i];
+            s[i] = y + v;
+            x = y;
+        }
+
+        samples[n] = x;
+    }
+}
+
+namespace DeepMindDSP
+{
+    template class IR3109Filter<float>;
+    template class IR3109Filter<juce::dsp::SIMDRegister<float>>;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <JuceHeader.h>
+
+namespace DeepMindDSP
+{
+    // DeepMind VCF: IR3109-style OTA cascade (4 x one-pole) with global resonance feedback.
+    // Zero-delay-feedback (TPT) topology. The feedback loop is solved linearly and the
+    // saturation is applied to the solved loop input, so there is no Newton iteration.
+    //
+    // Templated on SampleType so the same code runs on a float (one voice) or on a
+    // juce::dsp::SIMDRegister<float> (one voice per lane, all lanes in lock-step).
+    template <typename SampleType>
+    class IR3109Filter
+    {
+    public:
+        using NumericType = typename juce::dsp::SampleTypeHelpers::ElementType<SampleType>::Type;
+
+        IR3109Filter();
+
+        void prepare(double sampleRate);
+        void reset();
+
+        // Process in place (mono / one voice per SIMD lane)
+        void process(SampleType* samples, size_t numSamples);
+
+        // Parameters (per lane when SampleType is a SIMD register)
+        void setCutoff(SampleType frequency);
+        void setResonance(SampleType resonance); // 0..1, 4-pole self-oscillates near 1.0
+        void setTwoPole(bool shouldUseTwoPoles);
+        void setDrive(NumericType drive);        // 1.0 = clean
+
+    private:
+        template <int NumPoles>
+        void processPoles(SampleType* samples, size_t numSamples);
+
+        void updateCoefficients();
+
+        double sampleRate = 44100.0;
+        bool twoPole = false;
+
+        SampleType cutoff { 1000.0f };
+        SampleType resonance { 0.0f };
+        NumericType drive = 1.0f;
+
+        // Cached coefficients
+        SampleType G { 0.0f };          // g / (1 + g)
+        SampleType oneMinusG { 1.0f };  // 1 / (1 + g)
+        SampleType k { 0.0f };          // Loop gain
+        SampleType loopNorm { 1.0f };   // 1 / (1 + k * G^N)
+        SampleType inputGain { 1.0f };  // Passband loss compensation
+
+        // Integrator states (TPT)
+        SampleType s[4];
+    };
+}
@@ -10,66 +10,46 @@ MultiFilter::~MultiFilter()
 {
 }
 
-void MultiFilter::prepare(const juce::dsp::ProcessSpec& spec)
+void MultiFilter::prepare(const juce::dsp::ProcessSpec& monoSpec)
 {
+    // Mono by design, whatever the caller's channel count
+    auto spec = monoSpec;
+    spec.numChannels = 1;
+    
     ladderFilter.prepare(spec);
     svFilter.prepare(spec);
+    ir3109.prepare(spec.sampleRate);
     
-    // Initialize waveshaper with basic tanh for now
-    distortionSat.prepare(spec);
-    distortionSat.functionToUse = [](float x) { return std::tanh(x); };
+    // Modes are fixed per type, set once here instead of every block
+    ladderFilter.setMode(juce::dsp::LadderFilterMode::LPF24); // 18dB not available for Acid, 24dB for both
+    svFilter.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
 }
 
 void MultiFilter::reset()
 {
     ladderFilter.reset();
     svFilter.reset();
-    distortionSat.reset();
-}
-
-void MultiFilter::process(juce::dsp::AudioBlock<float>& block)
-{
-    juce::dsp::ProcessContextReplacing<float> context(block);
-
-    switch (currentType)
-    {
-        case FilterType::Jupiter:
-        {
-            // Classic Clean Ladder (24dB)
-            ladderFilter.setMode(juce::dsp::LadderFilterMode::LPF24);
-            ladderFilter.process(context);
-            break;
-        }
-
-        case FilterType::MS20:
-        {
-            // Screaming 20: Input Saturation -> State Variable Filter
-            // Apply slight drive before filter
-            distortionSat.process(context);
-            
-            svFilter.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
-            svFilter.process(context);
-            break;
-        }
-
-        case FilterType::Acid303:
-        {
-            // Acid: Input Boost/Distortion -> Ladder Filter High Res
-            // Boost input for character
-            // (In a block context, simple gain is easiest applied via iterating or a gain processor, 
-            // but for now let's reuse the saturator which limits peaks too).
-            distortionSat.process(context);
-            
-            ladderFilter.setMode(juce::dsp::LadderFilterMode::LPF24); // 18dB not available, fallback to 24dB
-            ladderFilter.process(context);
-            break;
-        }
-    }
+    ir3109.reset();
 }
 
 void MultiFilter::setType(FilterType type)
 {
+    if (type == currentType) return;
     currentType = type;
+    
+    static constexpr ProcessKernel kernels[] = {
+        &MultiFilter::processAs<FilterType::Jupiter>,
+        &MultiFilter::processAs<FilterType::MS20>,
+        &MultiFilter::processAs<FilterType::Acid303>,
+        &MultiFilter::processAs<FilterType::DeepMind>
+    };
+    
+    auto index = juce::jlimit(0, 3, (int)type);
+    processKernel = kernels[index];
+    
+    // setCutoff only updated the model that was active, so bring the new one up to
+    // date (resonance and drive are applied to every model, nothing to redo there)
+    setCutoff(currentCutoff);
 }
 
 void MultiFilter::setCutoff(float frequency)
@@ -80,8 +60,16 @@ void MultiFilter::setCutoff(float frequency)
     
     currentCutoff = frequency; // Store for getter
     
-    ladderFilter.setCutoffFrequencyHz(frequency);
-    svFilter.setCutoffFrequency(frequency);
+    // Only the active model pays for coefficient updates
+    if (currentType == FilterType::DeepMind)
+    {
+        ir3109.setCutoff(frequency);
+    }
+    else
+    {
+        ladderFilter.setCutoffFrequencyHz(frequency);
+        svFilter.setCutoffFrequency(frequency);
+    }
 }
 
 float MultiFilter::getCutoff() const
@@ -108,12 +96,16 @@ void MultiFilter::setResonance(float resonance)
     // MS-20 screams. High Q required.
     // Map 0 -> 0.707, 1 -> 24.0 (Aggressive)
     svFilter.setResonance(juce::jmap(calibratedRes, 0.707f, 24.0f));
+    
+    // IR3109: loop gain maps linearly, self-oscillation at max in 4-pole mode
+    ir3109.setResonance(calibratedRes);
 }
 
 void MultiFilter::setDrive(float drive)
 {
     // Ladder filter drive
     ladderFilter.setDrive(1.0f + (drive * 2.0f)); // 1.0 to 3.0 range
+    ir3109.setDrive(1.0f + (drive * 2.0f));
     
     // Distortion Saturation gain
     // Tanh behaves differently based on input gain.
@@ -121,3 +113,8 @@ void MultiFilter::setDrive(float drive)
     // Since we don't have a gain member, we can't easily set it here without modifying the class.
     // For now, Ladder Drive is the main parameter impacted by this.
 }
+
+void MultiFilter::setTwoPole(bool twoPole)
+{
+    ir3109.setTwoPole(twoPole);
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <JuceHeader.h>
+#include "IR3109Filter.h"
 
 namespace DeepMindDSP
 {
@@ -7,7 +8,8 @@ namespace DeepMindDSP
     {
         Jupiter, // Ladder 24dB
         MS20,    // StateVariable TPT + Drive
-        Acid303  // Distorted Ladder
+        Acid303, // Distorted Ladder
+        DeepMind // IR3109 OTA Cascade 12/24dB (ZDF)
     };
 
     class MultiFilter
@@ -19,13 +21,49 @@ namespace DeepMindDSP
         void prepare(const juce::dsp::ProcessSpec& spec);
         void reset();
 
-        void process(juce::dsp::AudioBlock<float>& block);
+        // Mono, in place (a voice is filtered once, not per output channel).
+        // Goes through the kernel picked by setType, no per-call switch.
+        void process(float* samples, int numSamples) { (this->*processKernel)(samples, numSamples); }
+        
+        // Same, with the type fixed at compile time (for callers that are
+        // themselves specialised per filter type, e.g. the voice render kernels)
+        template <FilterType Type>
+        void processAs(float* samples, int numSamples)
+        {
+            juce::dsp::AudioBlock<float> block(&samples, 1, (size_t)numSamples);
+            juce::dsp::ProcessContextReplacing<float> context(block);
+            
+            if constexpr (Type == FilterType::Jupiter)
+            {
+                // Classic Clean Ladder (24dB)
+                ladderFilter.process(context);
+            }
+            else if constexpr (Type == FilterType::MS20)
+            {
+                // Screaming 20: Input Saturation -> State Variable Filter
+                saturate(samples, numSamples);
+                svFilter.process(context);
+            }
+            else if constexpr (Type == FilterType::Acid303)
+            {
+                // Acid: Input Boost/Distortion -> Ladder Filter High Res
+                saturate(samples, numSamples);
+                ladderFilter.process(context);
+            }
+            else
+            {
+                // Native IR3109 model, in place
+                ir3109.process(samples, (size_t)numSamples);
+            }
+        }
 
         void setType(FilterType type);
+        FilterType getType() const { return currentType; }
         void setCutoff(float frequency);
         float getCutoff() const; // Getter added
         void setResonance(float resonance);
         void setDrive(float drive);
+        void setTwoPole(bool twoPole); // DeepMind 12dB mode
 
     private:
         FilterType currentType = FilterType::Jupiter;
@@ -34,8 +72,16 @@ namespace DeepMindDSP
         // Filter Instances
         juce::dsp::LadderFilter<float> ladderFilter;
         juce::dsp::StateVariableTPTFilter<float> svFilter;
+        IR3109Filter<float> ir3109;
+        
+        // Saturation stage for Acid/MS20 drive (inline, no indirect call per sample)
+        static void saturate(float* samples, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                samples[i] = std::tanh(samples[i]);
+        }
         
-        // Saturation stages
-        juce::dsp::WaveShaper<float> distortionSat; // For Acid/MS20 drive
+        using ProcessKernel = void (MultiFilter::*)(float*, int);
+        ProcessKernel processKernel = &MultiFilter::processAs<FilterType::Jupiter>;
     };
 }
@@ -0,0 +1,86 @@
+// Kernel loop bodies, included once per ISA translation unit (KernelsAVX2.cpp etc.)
+// with DEEPMIND_KERNEL_ISA set to that unit's Isa value.
+//
+// No JUCE or standard library headers here or in the units (Kernels.h has no
+// includes either): their inline functions would be emitted with this unit's
+// target flags, and the linker could keep those copies for the whole program
+// (AVX code reached on a non-AVX CPU). Plain loops only.
+//
+// Loops are written so the compiler vectorises them at the unit's width: no calls,
+// no early exits, selects instead of branches.
+
+#ifndef DEEPMIND_KERNEL_ISA
+ #error "Define DEEPMIND_KERNEL_ISA before including KernelBodies.inl"
+#endif
+
+namespace
+{
+    void add(float* dst, const float* src, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dst[i] += src[i];
+    }
+
+    void addScaled(float* dst, const float* src, float gain, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dst[i] += src[i] * gain;
+    }
+
+    void multiply(float* dst, const float* src, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dst[i] *= src[i];
+    }
+
+    float peak(const float* src, int numSamples)
+    {
+        // Eight independent maxima so the reduction vectorises without -ffast-math
+        float lanes[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        int i = 0;
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            for (int l = 0; l < 8; ++l)
+            {
+                float a = src[i + l] < 0.0f ? -src[i + l] : src[i + l];
+                lanes[l] = a > lanes[l] ? a : lanes[l];
+            }
+        }
+
+        float result = 0.0f;
+        for (int l = 0; l < 8; ++l)
+            result = lanes[l] > result ? lanes[l] : result;
+
+        for (; i < numSamples; ++i)
+        {
+            float a = src[i] < 0.0f ? -src[i] : src[i];
+            result = a > result ? a : result;
+        }
+        return result;
+    }
+
+    void sawPulse(float* dst, const float* saw, float threshold, float sawGain, float pulseGain, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float pulse = saw[i] > threshold ? pulseGain : -pulseGain;
+            dst[i] += saw[i] * sawGain + pulse;
+        }
+    }
+
+    void addDifference(float* dst, const float* wet, const float* dry, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dst[i] += wet[i] - dry[i];
+    }
+
+    const DeepMindDSP::Kernels::Table kernelTable {
+        DEEPMIND_KERNEL_ISA,
+        &add,
+        &addScaled,
+        &multiply,
+        &peak,
+        &sawPulse,
+        &addDifference
+    };
+}
@@ -0,0 +1,111 @@
+#include "Kernels.h"
+#include <JuceHeader.h>
+#include <atomic>
+
+using namespace DeepMindDSP;
+
+namespace
+{
+    std::atomic<const Kernels::Table*> activeTable { nullptr };
+
+    const Kernels::Table* tableFor(Kernels::Isa isa)
+    {
+        switch (isa)
+        {
+            case Kernels::Isa::Scalar: return Kernels::getScalarTable();
+            case Kernels::Isa::SSE2:   return Kernels::getSse2Table();
+            case Kernels::Isa::AVX2:   return Kernels::getAvx2Table();
+            case Kernels::Isa::AVX512: return Kernels::getAvx512Table();
+            case Kernels::Isa::NEON:   return Kernels::getNeonTable();
+        }
+        return nullptr;
+    }
+
+    bool cpuHas(Kernels::Isa isa)
+    {
+        switch (isa)
+        {
+            case Kernels::Isa::Scalar: return true;
+            case Kernels::Isa::SSE2:   return juce::SystemStats::hasSSE2();
+            case Kernels::Isa::AVX2:   return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3();
+            case Kernels::Isa::AVX512: return juce::SystemStats::hasAVX512F() && juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3();
+            case Kernels::Isa::NEON:   return juce::SystemStats::hasNeon();
+        }
+        return false;
+    }
+
+    const Kernels::Table* selectInitial()
+    {
+        auto isa = Kernels::getBestSupportedIsa();
+
+        // Override for benchmarking / A-B listening
+        auto forced = juce::SystemStats::getEnvironmentVariable("DEEPMIND_ISA", {}).trim().toLowerCase();
+        if (forced.isNotEmpty())
+        {
+            for (auto candidate : { Kernels::Isa::Scalar, Kernels::Isa::SSE2, Kernels::Isa::AVX2,
+                                    Kernels::Isa::AVX512, Kernels::Isa::NEON })
+            {
+                if (forced == juce::String(Kernels::getName(candidate)).toLowerCase() && Kernels::isSupported(candidate))
+                    isa = candidate;
+            }
+        }
+
+        const auto* table = tableFor(isa);
+        activeTable.store(table);
+        return table;
+    }
+}
+
+const Kernels::Table& Kernels::get()
+{
+    auto* table = activeTable.load(std::memory_order_acquire);
+    if (table == nullptr)
+        table = selectInitial(); // First call (idempotent if two threads race)
+    return *table;
+}
+
+Kernels::Isa Kernels::getActiveIsa()
+{
+    return get().isa;
+}
+
+bool Kernels::isSupported(Isa isa)
+{
+    return tableFor(isa) != nullptr && cpuHas(isa);
+}
+
+Kernels::Isa Kernels::getBestSupportedIsa()
+{
+    for (auto isa : { Isa::AVX512, Isa::AVX2, Isa::NEON, Isa::SSE2 })
+        if (isSupported(isa))
+            return isa;
+
+    return Isa::Scalar;
+}
+
+const char* Kernels::getName(Isa isa)
+{
+    switch (isa)
+    {
+        case Isa::Scalar: return "Scalar";
+        case Isa::SSE2:   return "SSE2";
+        case Isa::AVX2:   return "AVX2";
+        case Isa::AVX512: return "AVX512";
+        case Isa::NEON:   return "NEON";
+    }
+    return "Unknown";
+}
+
+bool Kernels::forceIsa(Isa isa)
+{
+    if (!isSupported(isa))
+        return false;
+
+    activeTable.store(tableFor(isa));
+    return true;
+}
+
+void Kernels::resetToBestIsa()
+{
+    activeTable.store(tableFor(getBestSupportedIsa()));
+}
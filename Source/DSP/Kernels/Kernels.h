@@ -0,0 +1,66 @@
+#pragma once
+
+// No includes on purpose: the per-ISA units include this with AVX/AVX-512 flags
+// (see KernelBodies.inl)
+
+namespace DeepMindDSP
+{
+    // Multi-versioned inner loops (mixing, oscillator output, FX sums).
+    // The same loop bodies (KernelBodies.inl) are compiled once per ISA, each in its
+    // own translation unit with its own target flags (see CMakeLists.txt), and the
+    // best table for this CPU is picked once at startup. One binary runs AVX2 or
+    // AVX-512 where available and SSE2 everywhere else; on AArch64 it's NEON.
+    namespace Kernels
+    {
+        enum class Isa
+        {
+            Scalar,  // Reference, vectorisation disabled
+            SSE2,
+            AVX2,    // + FMA
+            AVX512,  // AVX-512F
+            NEON
+        };
+
+        struct Table
+        {
+            Isa isa;
+
+            // dst += src
+            void (*add)(float* dst, const float* src, int numSamples);
+            // dst += src * gain
+            void (*addScaled)(float* dst, const float* src, float gain, int numSamples);
+            // dst *= src
+            void (*multiply)(float* dst, const float* src, int numSamples);
+            // max |src|
+            float (*peak)(const float* src, int numSamples);
+
+            // Oscillator: dst += saw * sawGain + (saw > threshold ? pulseGain : -pulseGain)
+            void (*sawPulse)(float* dst, const float* saw, float threshold, float sawGain, float pulseGain, int numSamples);
+
+            // FX parallel sum: dst += wet - dry (adds one effect's contribution)
+            void (*addDifference)(float* dst, const float* wet, const float* dry, int numSamples);
+        };
+
+        // Active table. Cheap; fetch once per block, not per sample.
+        const Table& get();
+
+        Isa getActiveIsa();
+        Isa getBestSupportedIsa();
+        bool isSupported(Isa isa);
+        const char* getName(Isa isa);
+
+        // Forced override (benchmarks, A/B checks). Returns false and leaves the active
+        // table unchanged if the CPU or build doesn't have that ISA.
+        // The DEEPMIND_ISA environment variable ("scalar", "sse2", "avx2", "avx512",
+        // "neon") does the same at startup.
+        bool forceIsa(Isa isa);
+        void resetToBestIsa();
+
+        // Per-ISA tables, nullptr when that ISA isn't built for this architecture
+        const Table* getScalarTable();
+        const Table* getSse2Table();
+        const Table* getAvx2Table();
+        const Table* getAvx512Table();
+        const Table* getNeonTable();
+    }
+}
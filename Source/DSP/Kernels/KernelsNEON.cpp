@@ -0,0 +1,21 @@
+// Kernels built for NEON (baseline on AArch64, so no extra flags).
+#include "Kernels.h"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#define DEEPMIND_KERNEL_ISA DeepMindDSP::Kernels::Isa::NEON
+#include "KernelBodies.inl"
+
+const DeepMindDSP::Kernels::Table* DeepMindDSP::Kernels::getNeonTable()
+{
+    return &kernelTable;
+}
+
+#else
+
+const DeepMindDSP::Kernels::Table* DeepMindDSP::Kernels::getNeonTable()
+{
+    return nullptr;
+}
+
+#endif
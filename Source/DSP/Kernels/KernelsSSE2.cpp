@@ -0,0 +1,22 @@
+// Kernels built for SSE2 (x86-64 baseline, -msse2 on 32-bit x86).
+// Only called after the CPU check in Kernels.cpp.
+#include "Kernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+
+#define DEEPMIND_KERNEL_ISA DeepMindDSP::Kernels::Isa::SSE2
+#include "KernelBodies.inl"
+
+const DeepMindDSP::Kernels::Table* DeepMindDSP::Kernels::getSse2Table()
+{
+    return &kernelTable;
+}
+
+#else
+
+const DeepMindDSP::Kernels::Table* DeepMindDSP::Kernels::getSse2Table()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,11 @@
+// Reference kernels: built with auto-vectorisation off (see CMakeLists.txt), so
+// benchmarks have a true scalar baseline to compare against.
+#include "Kernels.h"
+
+#define DEEPMIND_KERNEL_ISA DeepMindDSP::Kernels::Isa::Scalar
+#include "KernelBodies.inl"
+
+const DeepMindDSP::Kernels::Table* DeepMindDSP::Kernels::getScalarTable()
+{
+    return &kernelTable;
+}
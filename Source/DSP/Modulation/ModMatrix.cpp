@@ -34,6 +34,7 @@ void ModMatrix::process(const ModSources& src, ModDestinations& dst)
 
         // Fetch Source (Matches index in PluginProcessor/ModMatrixEditor)
         // 1=LFO1, 2=LFO2, 3=EnvMod, 4=Velocity, 5=ModWheel, 6=KeyTrack
+        // 7=EnvVcf, 8=EnvVca, 9=CtrlSeq, 10=PitchBend, 11=Pressure, 12=Timbre
         switch (slot.sourceIndex)
         {
             case 1: sourceValue = src.lfo1; break;
@@ -45,6 +46,9 @@ void ModMatrix::process(const ModSources& src, ModDestinations& dst)
             case 7: sourceValue = src.envVcf; break; // Added
             case 8: sourceValue = src.envVca; break; // Added
             case 9: sourceValue = src.ctrlSeq; break;
+            case 10: sourceValue = src.pitchBend; break;
+            case 11: sourceValue = src.pressure; break;
+            case 12: sourceValue = src.timbre; break;
         }
 
         float amount = sourceValue * slot.amount;
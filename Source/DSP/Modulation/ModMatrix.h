@@ -14,6 +14,9 @@ namespace DeepMindDSP
         float envVcf = 0.0f; // Added
         float envVca = 0.0f; // Added
         float ctrlSeq = 0.0f; // Control Sequencer
+        float pitchBend = 0.0f; // -1..1 (per-note in MPE)
+        float pressure = 0.0f;  // Aftertouch / MPE pressure
+        float timbre = 0.0f;    // CC 74 / MPE slide
     };
 
     struct ModDestinations
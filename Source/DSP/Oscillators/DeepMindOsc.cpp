@@ -1,4 +1,5 @@
 #include "DeepMindOsc.h"
+#include "../Kernels/Kernels.h"
 
 using namespace DeepMindDSP;
 
@@ -59,34 +60,61 @@ void DeepMindOsc::setColor(float color)
 }
 
 
-void DeepMindOsc::processBlock(juce::dsp::AudioBlock<float>& block)
+void DeepMindOsc::process(float* output, int numSamples, float gain)
 {
-    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    // The phasor has to run sample by sample (juce::dsp::Oscillator), but the
+    // pulse derivation and the mix are a plain loop: done per chunk by the
+    // dispatched kernel (AVX2 / SSE2 / NEON).
+    //
+    // Pulse with PWM:
+    // Standard naive pulse is (phase < pwm ? 1 : -1).
+    // JUCE Oscillator doesn't support dynamic PWM easily in the lambda without capturing state.
+    // For this iteration, let's use the Saw to derive Pulse.
+    // Pulse = (Saw > PWM_Thresh) ? 1 : -1
+    const float pulseThreshold = currentPwm * 2.0f - 1.0f;
+    const float sawGain = sawLevel * gain;
+    const float pulseGain = pulseLevel * gain;
+    const auto& kernels = Kernels::get();
+    
+    constexpr int chunkSamples = 64;
+    float saw[chunkSamples];
+    
+    for (int start = 0; start < numSamples; start += chunkSamples)
     {
-        auto* samples = block.getChannelPointer(channel);
+        int n = juce::jmin(chunkSamples, numSamples - start);
+        for (int i = 0; i < n; ++i)
+            saw[i] = oscSaw.processSample(0.0f);
         
-        // Creating a temporary block for oscillators allows them to process efficiently
-        // But since we need to mix Saw and Pulse per sample with PWM, 
-        // iterating sample-by-sample is safer for now to handle PWM modulation correctly.
+        // Mix, add to existing (layer / voice sum)
+        kernels.sawPulse(output + start, saw, pulseThreshold, sawGain, pulseGain, n);
+    }
+}
+
+void DeepMindOsc::processBlock(juce::dsp::AudioBlock<float>& block)
+{
+    // The phase must advance once per sample, not once per channel: render
+    // channel 0, then add the same signal to the others
+    if (block.getNumChannels() == 0) return;
+    
+    auto numSamples = (int)block.getNumSamples();
+    auto* first = block.getChannelPointer(0);
+    
+    if (block.getNumChannels() == 1)
+    {
+        process(first, numSamples);
+        return;
+    }
+    
+    // Keep channel 0's previous content apart from what we generate
+    float scratch[256];
+    for (int start = 0; start < numSamples; start += 256)
+    {
+        int n = juce::jmin(256, numSamples - start);
+        juce::FloatVectorOperations::clear(scratch, n);
+        process(scratch, n);
         
-        for (size_t i = 0; i < block.getNumSamples(); ++i)
-        {
-            float saw = oscSaw.processSample(0.0f);
-            
-            // Pulse with PWM:
-            // Standard naive pulse is (phase < pwm ? 1 : -1).
-            // JUCE Oscillator doesn't support dynamic PWM easily in the lambda without capturing state.
-            // We will approximate it by modifying the output of a standard square wave or using a custom phasor.
-            // For this iteration, let's use the Saw to derive Pulse.
-            // Pulse = (Saw > PWM_Thresh) ? 1 : -1
-            
-            float pulse = (saw > (currentPwm * 2.0f - 1.0f)) ? 1.0f : -1.0f;
-            
-            // Mix
-            float mixed = (saw * sawLevel) + (pulse * pulseLevel);
-            
-            samples[i] += mixed; // Add to existing (polyphony sum)
-        }
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            juce::FloatVectorOperations::add(block.getChannelPointer(ch) + start, scratch, n);
     }
 }
 
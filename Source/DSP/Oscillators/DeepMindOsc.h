@@ -12,7 +12,10 @@ namespace DeepMindDSP
         void prepare(const juce::dsp::ProcessSpec& spec);
         void reset();
         
-        // Main processing block
+        // Mono: adds gain * output to 'output' (one phase step per sample)
+        void process(float* output, int numSamples, float gain = 1.0f);
+        
+        // Multi-channel wrapper: renders once and adds the same signal to every channel
         void processBlock(juce::dsp::AudioBlock<float>& block);
 
         // Parameters sets frequency
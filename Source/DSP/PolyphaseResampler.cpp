@@ -0,0 +1,191 @@
+#include "PolyphaseResampler.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace DeepMindDSP;
+
+namespace
+{
+    // Modified Bessel function of the first kind, order 0 (Kaiser window)
+    double besselI0(double x)
+    {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (x * 0.5 / k) * (x * 0.5 / k);
+            sum += term;
+            if (term < sum * 1.0e-12) break;
+        }
+        return sum;
+    }
+
+    float dot(const float* a, const float* b, int n)
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < n; ++i)
+            sum += a[i] * b[i];
+        return sum;
+    }
+}
+
+void PolyphaseResampler::prepare(int newFactor, int newNumChannels, int newMaximumHostBlock)
+{
+    factor = juce::jmax(1, newFactor);
+    numChannels = juce::jmax(1, newNumChannels);
+    maximumHostBlock = juce::jmax(1, newMaximumHostBlock);
+
+    designFilter();
+
+    const int taps = (int)kernel.size();
+    decimatorInput.assign((size_t)numChannels, std::vector<float>((size_t)(taps - 1 + maximumHostBlock), 0.0f));
+    interpolatorInput.assign((size_t)numChannels, std::vector<float>((size_t)(TapsPerPhase - 1 + getMaximumInternalBlock()), 0.0f));
+    outputFifo.assign((size_t)numChannels, std::vector<float>((size_t)(maximumHostBlock + 2 * factor), 0.0f));
+
+    reset();
+}
+
+void PolyphaseResampler::reset()
+{
+    for (auto* buffers : { &decimatorInput, &interpolatorInput, &outputFifo })
+        for (auto& channel : *buffers)
+            std::fill(channel.begin(), channel.end(), 0.0f);
+
+    phase = blockPhase = 0;
+    blockHostSamples = blockInternalSamples = 0;
+    fifoLevel = factor - 1; // Enough that no block can run the FIFO dry
+}
+
+int PolyphaseResampler::getLatencySamples() const
+{
+    if (factor == 1) return 0;
+
+    // Group delay of both linear-phase filters, (taps - 1) / 2 each. The FIFO priming
+    // exactly offsets the decimator's alignment, so it adds nothing.
+    return (int)kernel.size() - 1;
+}
+
+void PolyphaseResampler::designFilter()
+{
+    const int taps = factor * TapsPerPhase;
+    kernel.assign((size_t)taps, 0.0f);
+
+    if (factor == 1)
+    {
+        kernel.assign(1, 1.0f);
+        subFilters.assign(1, std::vector<float>(1, 1.0f));
+        return;
+    }
+
+    // Cutoff just below the internal Nyquist (host-normalised), Kaiser beta 8
+    const double cutoff = 0.45 / factor;
+    const double beta = 8.0;
+    const double centre = (taps - 1) * 0.5;
+    const double norm = besselI0(beta);
+
+    double sum = 0.0;
+    std::vector<double> h((size_t)taps);
+    for (int n = 0; n < taps; ++n)
+    {
+        const double t = n - centre;
+        const double x = juce::MathConstants<double>::pi * 2.0 * cutoff * t;
+        const double sinc = std::abs(t) < 1.0e-9 ? 1.0 : std::sin(x) / x;
+        const double r = t / centre;
+        const double window = besselI0(beta * std::sqrt(juce::jmax(0.0, 1.0 - r * r))) / norm;
+        h[(size_t)n] = 2.0 * cutoff * sinc * window;
+        sum += h[(size_t)n];
+    }
+
+    for (int n = 0; n < taps; ++n)
+        kernel[(size_t)n] = (float)(h[(size_t)n] / sum); // Unity DC gain
+
+    // Interpolator: phase p uses taps p, p + factor, ... reversed so the newest input
+    // sample lines up with the last tap. Gain * factor makes up for the zero stuffing.
+    subFilters.assign((size_t)factor, std::vector<float>((size_t)TapsPerPhase, 0.0f));
+    for (int p = 0; p < factor; ++p)
+        for (int u = 0; u < TapsPerPhase; ++u)
+            subFilters[(size_t)p][(size_t)u] = kernel[(size_t)((TapsPerPhase - 1 - u) * factor + p)] * (float)factor;
+}
+
+int PolyphaseResampler::beginBlock(int hostSamples)
+{
+    jassert(hostSamples <= maximumHostBlock);
+
+    blockPhase = phase;
+    blockHostSamples = hostSamples;
+    blockInternalSamples = (phase + hostSamples) / factor;
+    phase = (phase + hostSamples) % factor;
+    return blockInternalSamples;
+}
+
+int PolyphaseResampler::toInternalOffset(int hostOffset) const
+{
+    // Internal sample k covers host samples [k * factor - blockPhase, (k + 1) * factor - blockPhase)
+    return juce::jlimit(0, juce::jmax(0, blockInternalSamples - 1), (hostOffset + blockPhase) / factor);
+}
+
+void PolyphaseResampler::downsample(const juce::AudioBuffer<float>& host, juce::AudioBuffer<float>& internal)
+{
+    const int taps = (int)kernel.size();
+    const int n = blockHostSamples;
+    jassert(internal.getNumChannels() >= numChannels);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto& buffer = decimatorInput[(size_t)ch];
+        float* input = buffer.data() + taps - 1;
+
+        if (ch < host.getNumChannels())
+            juce::FloatVectorOperations::copy(input, host.getReadPointer(ch), n);
+        else
+            juce::FloatVectorOperations::clear(input, n);
+
+        // One output at the end of every decimation period. The window ending at
+        // host sample i is buffer[i .. i + taps) (kernel is symmetric, no reversal).
+        float* out = internal.getWritePointer(ch);
+        int k = 0;
+        for (int i = factor - 1 - blockPhase; i < n; i += factor)
+            out[k++] = dot(kernel.data(), buffer.data() + i, taps);
+
+        jassert(k == blockInternalSamples);
+
+        // Keep the last taps - 1 inputs as history
+        std::copy(buffer.begin() + n, buffer.begin() + n + taps - 1, buffer.begin());
+    }
+}
+
+void PolyphaseResampler::upsample(const juce::AudioBuffer<float>& internal, juce::AudioBuffer<float>& host)
+{
+    const int m = blockInternalSamples;
+    const int n = blockHostSamples;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto& buffer = interpolatorInput[(size_t)ch];
+        float* input = buffer.data() + TapsPerPhase - 1;
+
+        if (ch < internal.getNumChannels())
+            juce::FloatVectorOperations::copy(input, internal.getReadPointer(ch), m);
+        else
+            juce::FloatVectorOperations::clear(input, m);
+
+        // 'factor' host samples per internal sample, appended to the FIFO
+        float* fifo = outputFifo[(size_t)ch].data();
+        float* out = fifo + fifoLevel;
+        for (int k = 0; k < m; ++k)
+            for (int p = 0; p < factor; ++p)
+                *out++ = dot(subFilters[(size_t)p].data(), buffer.data() + k, TapsPerPhase);
+
+        std::copy(buffer.begin() + m, buffer.begin() + m + TapsPerPhase - 1, buffer.begin());
+
+        // Hand the host its block, keep the remainder (< factor samples)
+        if (ch < host.getNumChannels())
+            juce::FloatVectorOperations::copy(host.getWritePointer(ch), fifo, n);
+        std::copy(fifo + n, fifo + fifoLevel + m * factor, fifo);
+    }
+
+    for (int ch = numChannels; ch < host.getNumChannels(); ++ch)
+        host.clear(ch, 0, n);
+
+    fifoLevel += m * factor - n;
+    jassert(fifoLevel >= 0 && fifoLevel < factor);
+}
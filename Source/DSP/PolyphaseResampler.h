@@ -0,0 +1,60 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+namespace DeepMindDSP
+{
+    // Host rate <-> internal engine rate by an integer factor (2 or 4), e.g. a 96 kHz
+    // host with the synth and FX running at 48 kHz.
+    // downsample() takes a host block to the internal rate (decimating FIR),
+    // upsample() takes the rendered internal block back (polyphase interpolator).
+    // Both use the same linear-phase Kaiser-windowed sinc, so the round trip has a
+    // fixed latency (getLatencySamples) that the processor reports to the host.
+    //
+    // Host blocks don't have to be multiples of the factor: the decimator carries its
+    // phase across blocks, and the interpolator keeps a short output FIFO (primed with
+    // factor - 1 samples) so every host block is filled exactly.
+    class PolyphaseResampler
+    {
+    public:
+        static constexpr int TapsPerPhase = 48; // ~80 dB stopband, flat to ~0.4 x internal rate
+
+        void prepare(int factor, int numChannels, int maximumHostBlock);
+        void reset();
+
+        int getFactor() const { return factor; }
+        int getLatencySamples() const; // Host samples, down + up
+        int getMaximumInternalBlock() const { return maximumHostBlock / factor + 1; }
+
+        // Call once per host block before the others. Returns how many internal
+        // samples this block produces (varies by one when hostSamples % factor != 0).
+        int beginBlock(int hostSamples);
+
+        // Host sample position in the current block -> internal position
+        int toInternalOffset(int hostOffset) const;
+
+        void downsample(const juce::AudioBuffer<float>& host, juce::AudioBuffer<float>& internal);
+        void upsample(const juce::AudioBuffer<float>& internal, juce::AudioBuffer<float>& host);
+
+    private:
+        void designFilter();
+
+        int factor = 1;
+        int numChannels = 0;
+        int maximumHostBlock = 0;
+
+        int phase = 0;        // Host samples into the current decimation period
+        int blockPhase = 0;   // 'phase' at the start of the current block
+        int blockHostSamples = 0;
+        int blockInternalSamples = 0;
+
+        std::vector<float> kernel;                 // factor * TapsPerPhase taps, symmetric
+        std::vector<std::vector<float>> subFilters; // Interpolator phases, reversed, gain * factor
+
+        // Per channel: [history | block] so every dot product is one contiguous run
+        std::vector<std::vector<float>> decimatorInput;
+        std::vector<std::vector<float>> interpolatorInput;
+        std::vector<std::vector<float>> outputFifo;
+        int fifoLevel = 0;
+    };
+}
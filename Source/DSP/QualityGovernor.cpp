@@ -0,0 +1,87 @@
+#include "QualityGovernor.h"
+#include <cmath>
+
+using namespace DeepMindDSP;
+
+namespace
+{
+    // Cheapest savings first: modulation rate and the widest stacks, then stereo unison
+    const QualityGovernor::Tier tiers[QualityGovernor::NumTiers] = {
+        { "Full",    12,  64, true  },
+        { "Reduced",  6, 128, true  },
+        { "Low",      4, 128, false },
+        { "Minimum",  2, 256, false }
+    };
+}
+
+const QualityGovernor::Tier& QualityGovernor::getTier(int index)
+{
+    return tiers[juce::jlimit(0, NumTiers - 1, index)];
+}
+
+void QualityGovernor::prepare(double newSampleRate, int)
+{
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+    reset();
+}
+
+void QualityGovernor::reset()
+{
+    smoothedLoad = 0.0f;
+    secondsSinceChange = 0.0;
+    secondsBelowUp = 0.0;
+    load.store(0.0f);
+    tier.store(0);
+}
+
+void QualityGovernor::setEnabled(bool shouldBeEnabled)
+{
+    enabled.store(shouldBeEnabled);
+    if (!shouldBeEnabled)
+        tier.store(0);
+}
+
+void QualityGovernor::stepTo(int newTier)
+{
+    tier.store(juce::jlimit(0, NumTiers - 1, newTier));
+    secondsSinceChange = 0.0;
+    secondsBelowUp = 0.0;
+}
+
+void QualityGovernor::blockFinished(double seconds, int numSamples)
+{
+    if (numSamples <= 0) return;
+
+    const double budget = numSamples / sampleRate;
+    const float blockLoad = (float)(seconds / budget);
+
+    // Instant attack, slow release: one slow block shows up at once
+    if (blockLoad > smoothedLoad)
+        smoothedLoad = blockLoad;
+    else
+        smoothedLoad += (blockLoad - smoothedLoad) * (float)(1.0 - std::exp(-budget / releaseSeconds));
+
+    load.store(smoothedLoad);
+    secondsSinceChange += budget;
+
+    if (!enabled.load()) return;
+
+    const int current = tier.load();
+
+    // Down: this block nearly missed its deadline, or the load has stayed high
+    if (current < NumTiers - 1
+        && (blockLoad >= criticalLoad || (smoothedLoad >= downLoad && secondsSinceChange >= downDwellSeconds)))
+    {
+        stepTo(current + 1);
+        return;
+    }
+
+    // Up: only after a sustained quiet period
+    if (smoothedLoad < upLoad)
+        secondsBelowUp += budget;
+    else
+        secondsBelowUp = 0.0;
+
+    if (current > 0 && secondsBelowUp >= upHoldSeconds)
+        stepTo(current - 1);
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+
+namespace DeepMindDSP
+{
+    // Load-aware quality tiers.
+    // processBlock is timed against its real-time budget (block length). When the
+    // load gets close to the deadline the governor steps down one tier at a time;
+    // once it has been comfortably low for a while it steps back up. Down is fast
+    // (one bad block is enough), up is slow (hysteresis + hold) so it doesn't flap.
+    //
+    // The governor only decides. The processor reads getTierIndex() at the start of
+    // each block and applies the tier (voices, modulation rate).
+    class QualityGovernor
+    {
+    public:
+        struct Tier
+        {
+            const char* name;
+            int maxUnisonLayers;      // Cap on polyphony_mode's unison stack
+            int controlBlockSamples;  // Modulation / parameter update interval
+            bool stereoUnison;        // Unison width (second filter per voice)
+        };
+
+        static constexpr int NumTiers = 4;
+        static const Tier& getTier(int index);
+
+        void prepare(double sampleRate, int maximumBlockSize);
+        void reset();
+
+        // Off = pinned to the full quality tier
+        void setEnabled(bool shouldBeEnabled);
+        bool isEnabled() const { return enabled.load(); }
+
+        // Audio thread: how long one block took
+        void blockFinished(double seconds, int numSamples);
+
+        int getTierIndex() const { return tier.load(); }
+        float getLoad() const { return load.load(); } // Smoothed, 1.0 = whole budget used
+
+        // Times the enclosing scope (put it first in processBlock)
+        class ScopedBlock
+        {
+        public:
+            ScopedBlock(QualityGovernor& g, int samples)
+                : governor(g), numSamples(samples), start(juce::Time::getHighResolutionTicks()) {}
+
+            ~ScopedBlock()
+            {
+                auto ticks = juce::Time::getHighResolutionTicks() - start;
+                governor.blockFinished(juce::Time::highResolutionTicksToSeconds(ticks), numSamples);
+            }
+
+        private:
+            QualityGovernor& governor;
+            int numSamples;
+            juce::int64 start;
+
+            JUCE_DECLARE_NON_COPYABLE(ScopedBlock)
+        };
+
+    private:
+        void stepTo(int newTier);
+
+        // Policy
+        static constexpr float criticalLoad = 0.9f;    // Single block: step down now
+        static constexpr float downLoad = 0.75f;       // Sustained: step down
+        static constexpr float upLoad = 0.45f;         // Sustained below this: step up
+        static constexpr double downDwellSeconds = 0.25; // Between sustained step downs
+        static constexpr double upHoldSeconds = 3.0;   // Time below upLoad before stepping up
+        static constexpr double releaseSeconds = 0.5;  // Smoothing when load falls
+
+        double sampleRate = 44100.0;
+        float smoothedLoad = 0.0f;
+        double secondsSinceChange = 0.0;
+        double secondsBelowUp = 0.0;
+
+        std::atomic<bool> enabled { true };
+        std::atomic<int> tier { 0 };
+        std::atomic<float> load { 0.0f };
+    };
+}
@@ -0,0 +1,181 @@
+#include "TraceRecorder.h"
+
+#if DEEPMIND_TRACING
+
+using namespace DeepMindDSP;
+
+namespace
+{
+    constexpr int drainIntervalMs = 10; // A ring holds ~8k zones, plenty for 10 ms
+}
+
+TraceRecorder& TraceRecorder::getInstance()
+{
+    static TraceRecorder instance;
+    return instance;
+}
+
+TraceRecorder::TraceRecorder()
+    : rings(new Ring[maxThreads]) // Up front: claiming a ring must not allocate
+{
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    stop();
+}
+
+TraceRecorder::RingOwner::~RingOwner()
+{
+    if (ring == nullptr) return;
+
+    ring->threadName.store(nullptr);
+    ring->nameChanged.store(true);
+    ring->claimed.store(false, std::memory_order_release); // After this thread's last write
+}
+
+TraceRecorder::Ring* TraceRecorder::getThreadRing()
+{
+    thread_local RingOwner owner;
+    if (owner.ring != nullptr) return owner.ring;
+
+    for (int i = 0; i < maxThreads; ++i)
+    {
+        bool expected = false;
+        if (rings[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        {
+            rings[i].threadName.store(nullptr);
+            rings[i].nameChanged.store(true);
+            return owner.ring = &rings[i];
+        }
+    }
+
+    return nullptr; // More threads than rings: this one isn't traced
+}
+
+void TraceRecorder::nameThread(const char* name)
+{
+    if (auto* ring = getThreadRing())
+    {
+        ring->threadName.store(name);
+        ring->nameChanged.store(true);
+    }
+}
+
+void TraceRecorder::record(const char* name, juce::int64 start, juce::int64 end)
+{
+    auto* ring = getThreadRing();
+    if (ring == nullptr)
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const auto write = ring->writePosition.load(std::memory_order_relaxed);
+    if (write - ring->readPosition.load(std::memory_order_acquire) >= Ring::capacity)
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ring->events[write & (Ring::capacity - 1)] = { name, start, end };
+    ring->writePosition.store(write + 1, std::memory_order_release);
+}
+
+bool TraceRecorder::start(const juce::File& jsonFile)
+{
+    const juce::ScopedLock sl(fileLock);
+    if (recording.load()) return false;
+
+    jsonFile.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream>(jsonFile);
+    if (!stream->openedOk()) return false;
+
+    output = std::move(stream);
+    output->writeText("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", false, false, nullptr);
+    firstEvent = true;
+
+    // Anything still in the rings is from an earlier capture
+    for (int i = 0; i < maxThreads; ++i)
+    {
+        rings[i].readPosition.store(rings[i].writePosition.load());
+        rings[i].nameWritten = false;
+    }
+
+    dropped.store(0);
+    captureStart = juce::Time::getHighResolutionTicks();
+    ticksToMicroseconds = 1.0e6 / (double)juce::Time::getHighResolutionTicksPerSecond();
+    recording.store(true);
+
+    writer.startThread();
+    return true;
+}
+
+void TraceRecorder::stop()
+{
+    if (!recording.exchange(false)) return;
+
+    writer.stopThread(1000);
+
+    const juce::ScopedLock sl(fileLock);
+    drain(); // Zones that closed before 'recording' went false
+
+    output->writeText("\n]}\n", false, false, nullptr);
+    output->flush();
+    output.reset();
+}
+
+void TraceRecorder::Writer::run()
+{
+    while (!threadShouldExit())
+    {
+        wait(drainIntervalMs);
+
+        const juce::ScopedLock sl(recorder.fileLock);
+        recorder.drain();
+    }
+}
+
+void TraceRecorder::drain()
+{
+    if (output == nullptr) return;
+
+    auto separator = [this]() -> const char* {
+        if (firstEvent) { firstEvent = false; return ""; }
+        return ",\n";
+    };
+
+    for (int tid = 0; tid < maxThreads; ++tid)
+    {
+        // Released rings still drain: their last owner's events are in there
+        auto& ring = rings[tid];
+        const auto write = ring.writePosition.load(std::memory_order_acquire);
+        auto read = ring.readPosition.load(std::memory_order_relaxed);
+        if (read == write) continue;
+
+        if (ring.nameChanged.exchange(false))
+            ring.nameWritten = false;
+
+        if (!ring.nameWritten)
+        {
+            const char* name = ring.threadName.load();
+            *output << separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+                    << ",\"args\":{\"name\":\"" << (name != nullptr ? juce::String(name) : "Thread " + juce::String(tid)) << "\"}}";
+            ring.nameWritten = true;
+        }
+
+        for (; read != write; ++read)
+        {
+            const auto& event = ring.events[read & (Ring::capacity - 1)];
+            if (event.start < captureStart) continue; // Opened before the capture started
+
+            *output << separator() << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+                    << ",\"ts\":" << juce::String((double)(event.start - captureStart) * ticksToMicroseconds, 3)
+                    << ",\"dur\":" << juce::String((double)(event.end - event.start) * ticksToMicroseconds, 3) << "}";
+        }
+
+        ring.readPosition.store(read, std::memory_order_release);
+    }
+}
+
+#endif
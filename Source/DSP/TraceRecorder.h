@@ -0,0 +1,129 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Runtime tracing of the audio path (cmake -DDEEPMIND_ENABLE_TRACING=ON).
+//
+// DEEPMIND_TRACE_ZONE("name") times the enclosing scope. While a capture is running
+// each zone writes {name, start, end} into its thread's ring buffer (single
+// producer / single consumer, no locks, no allocation); a background thread drains
+// the rings into a Chrome trace JSON file (chrome://tracing, ui.perfetto.dev).
+// Full rings drop events (counted) rather than block.
+//
+// Zone names must be string literals: only the pointer is stored.
+// Without DEEPMIND_TRACING the macros are empty and none of this is compiled.
+#ifndef DEEPMIND_TRACING
+ #define DEEPMIND_TRACING 0
+#endif
+
+#if DEEPMIND_TRACING
+#include <atomic>
+#include <memory>
+
+namespace DeepMindDSP
+{
+    class TraceRecorder
+    {
+    public:
+        static TraceRecorder& getInstance();
+
+        // Not the audio thread (opens / closes the file)
+        bool start(const juce::File& jsonFile);
+        void stop();
+        static bool isRecording() { return recording.load(std::memory_order_relaxed); }
+        int getDroppedEvents() const { return dropped.load(); }
+
+        // Label for the calling thread in the trace (literal, e.g. "Audio"). The first
+        // getInstance() allocates the rings, so make that call off the audio thread.
+        void nameThread(const char* name);
+
+        class ScopedZone
+        {
+        public:
+            explicit ScopedZone(const char* zoneName)
+                : name(zoneName), start(isRecording() ? juce::Time::getHighResolutionTicks() : 0) {}
+
+            ~ScopedZone()
+            {
+                if (start != 0)
+                    getInstance().record(name, start, juce::Time::getHighResolutionTicks());
+            }
+
+        private:
+            const char* name;
+            juce::int64 start;
+
+            JUCE_DECLARE_NON_COPYABLE(ScopedZone)
+        };
+
+        ~TraceRecorder();
+
+    private:
+        TraceRecorder();
+
+        struct Event
+        {
+            const char* name;
+            juce::int64 start, end;
+        };
+
+        // One per live thread that has recorded a zone: claimed on first use, given back
+        // when the thread exits (its unread events still drain), so hosts that recreate
+        // their audio threads don't run out of rings
+        struct Ring
+        {
+            static constexpr juce::uint32 capacity = 8192; // Power of two
+            std::atomic<bool> claimed { false };
+            std::atomic<const char*> threadName { nullptr };
+            std::atomic<bool> nameChanged { false };       // New owner or new name
+            std::atomic<juce::uint32> writePosition { 0 }; // Owning thread only
+            std::atomic<juce::uint32> readPosition { 0 };  // drain() only
+            bool nameWritten = false;                      // drain() only
+            Event events[capacity];
+        };
+
+        // Owns the calling thread's ring (thread_local). Registering its destructor
+        // allocates once per thread, so name threads (DEEPMIND_TRACE_THREAD) at setup
+        // rather than let the first zone claim the ring.
+        struct RingOwner
+        {
+            Ring* ring = nullptr;
+            ~RingOwner();
+        };
+
+        static constexpr int maxThreads = 8;
+
+        void record(const char* name, juce::int64 start, juce::int64 end);
+        Ring* getThreadRing();
+        void drain(); // Writer thread (and stop())
+
+        class Writer : public juce::Thread
+        {
+        public:
+            explicit Writer(TraceRecorder& r) : juce::Thread("Trace writer"), recorder(r) {}
+            void run() override;
+
+        private:
+            TraceRecorder& recorder;
+        };
+
+        // Static so an idle zone never touches (or constructs) the instance
+        static inline std::atomic<bool> recording { false };
+
+        std::unique_ptr<Ring[]> rings;
+        std::atomic<int> dropped { 0 };
+
+        juce::CriticalSection fileLock; // start / stop / drain
+        std::unique_ptr<juce::FileOutputStream> output;
+        Writer writer { *this };
+        juce::int64 captureStart = 0;
+        double ticksToMicroseconds = 0.0;
+        bool firstEvent = true;
+    };
+}
+
+ #define DEEPMIND_TRACE_ZONE(name) DeepMindDSP::TraceRecorder::ScopedZone JUCE_JOIN_MACRO(deepmindTraceZone_, __LINE__) (name)
+ #define DEEPMIND_TRACE_THREAD(name) DeepMindDSP::TraceRecorder::getInstance().nameThread(name)
+#else
+ #define DEEPMIND_TRACE_ZONE(name)
+ #define DEEPMIND_TRACE_THREAD(name)
+#endif
@@ -0,0 +1,158 @@
+#include "OscFeedbackSender.h"
+
+namespace data
+{
+    OscFeedbackSender::OscFeedbackSender(const StateSerializer& layout)
+        : juce::Thread("OSC Feedback")
+    {
+        const int numParams = layout.getNumParameters();
+        numDirtyWords = (numParams + bitsPerWord - 1) / bitsPerWord;
+        dirty.reset(new std::atomic<juce::uint64>[(size_t)juce::jmax(1, numDirtyWords)]);
+        for (int w = 0; w < numDirtyWords; ++w)
+            dirty[(size_t)w].store(0);
+
+        parameters.reserve((size_t)numParams);
+        addresses.reserve((size_t)numParams);
+        for (int i = 0; i < numParams; ++i)
+        {
+            auto* param = layout.getParameter(i);
+            parameters.push_back(param);
+            addresses.emplace_back("/deepmind/" + layout.getParameterID(i));
+
+            int processorIndex = param->getParameterIndex();
+            if (processorIndex >= (int)processorToLayout.size())
+                processorToLayout.resize((size_t)processorIndex + 1, -1);
+            processorToLayout[(size_t)processorIndex] = i;
+
+            param->addListener(this);
+        }
+    }
+
+    OscFeedbackSender::~OscFeedbackSender()
+    {
+        for (auto* param : parameters)
+            param->removeListener(this);
+
+        stopThread(2000);
+        disconnect();
+    }
+
+    bool OscFeedbackSender::connect(const juce::String& targetHost, int port)
+    {
+        // One check-and-start under the lock, so two retargets at once (message thread
+        // and an OSC /deepmind/feedback) can't both start the thread or read a stale flag.
+        // The worker only takes the lock inside flush, so starting it here can't deadlock.
+        const juce::ScopedLock sl(senderLock);
+        connected = sender.connect(targetHost, port);
+
+        if (connected && !isThreadRunning())
+            startThread();
+
+        return connected;
+    }
+
+    void OscFeedbackSender::disconnect()
+    {
+        const juce::ScopedLock sl(senderLock);
+        if (connected)
+            sender.disconnect();
+        connected = false;
+    }
+
+    void OscFeedbackSender::setRate(double flushesPerSecond)
+    {
+        flushIntervalMs.store(juce::jlimit(1, 1000, juce::roundToInt(1000.0 / juce::jmax(1.0, flushesPerSecond))));
+    }
+
+    void OscFeedbackSender::setMaxMessagesPerBundle(int maxMessages)
+    {
+        maxMessagesPerBundle.store(juce::jmax(1, maxMessages));
+    }
+
+    void OscFeedbackSender::markAllDirty()
+    {
+        for (int i = 0; i < (int)parameters.size(); ++i)
+            dirty[(size_t)(i / bitsPerWord)].fetch_or((juce::uint64)1 << (i % bitsPerWord));
+        
+        qualityTierDirty.store(true);
+    }
+
+    void OscFeedbackSender::setQualityTier(int tier)
+    {
+        if (qualityTier.exchange(tier) != tier)
+            qualityTierDirty.store(true);
+    }
+
+    void OscFeedbackSender::parameterValueChanged(int parameterIndex, float)
+    {
+        // Only a bit: the value itself is read at flush time (latest wins)
+        if (parameterIndex < 0 || parameterIndex >= (int)processorToLayout.size()) return;
+
+        int index = processorToLayout[(size_t)parameterIndex];
+        if (index >= 0)
+            dirty[(size_t)(index / bitsPerWord)].fetch_or((juce::uint64)1 << (index % bitsPerWord));
+    }
+
+    //==============================================================================
+    // Worker
+
+    void OscFeedbackSender::run()
+    {
+        while (!threadShouldExit())
+        {
+            auto start = juce::Time::getMillisecondCounter();
+            flush();
+
+            auto elapsed = (int)(juce::Time::getMillisecondCounter() - start);
+            wait(juce::jmax(1, flushIntervalMs.load() - elapsed));
+        }
+    }
+
+    void OscFeedbackSender::flush()
+    {
+        const int maxMessages = maxMessagesPerBundle.load();
+        juce::OSCBundle bundle;
+        int inBundle = 0;
+        
+        if (qualityTierDirty.exchange(false))
+        {
+            bundle.addElement(juce::OSCMessage("/deepmind/status/quality_tier", qualityTier.load()));
+            ++inBundle;
+        }
+
+        for (int w = 0; w < numDirtyWords; ++w)
+        {
+            auto bits = dirty[(size_t)w].exchange(0);
+            while (bits != 0)
+            {
+                int bit = juce::countNumberOfBits(((bits & (~bits + 1)) - 1)); // Lowest set bit
+                bits &= bits - 1;
+
+                int index = w * bitsPerWord + bit;
+                bundle.addElement(juce::OSCMessage(addresses[(size_t)index], parameters[(size_t)index]->getValue()));
+
+                if (++inBundle == maxMessages)
+                {
+                    sendBundle(bundle);
+                    bundle = juce::OSCBundle();
+                    inBundle = 0;
+                }
+            }
+        }
+
+        if (inBundle > 0)
+            sendBundle(bundle);
+    }
+
+    bool OscFeedbackSender::sendBundle(juce::OSCBundle& bundle)
+    {
+        const juce::ScopedLock sl(senderLock);
+        if (!connected) return false;
+
+        if (!sender.send(bundle)) return false;
+
+        packetsSent.fetch_add(1);
+        messagesSent.fetch_add(bundle.size());
+        return true;
+    }
+}
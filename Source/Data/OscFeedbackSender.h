@@ -0,0 +1,68 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "StateSerializer.h"
+
+namespace data
+{
+    // OSC parameter feedback (port 9000 TX).
+    // Parameter changes only set a dirty bit (lock-free, safe from the audio thread).
+    // A background thread flushes the dirty set at a fixed rate as OSC bundles of
+    // /deepmind/{param_id} <float 0..1>, sending the latest value of each parameter
+    // once. A sweep costs one message per flush, and a preset load becomes a short
+    // burst of bundles instead of hundreds of single-message packets.
+    class OscFeedbackSender : private juce::Thread,
+                              private juce::AudioProcessorParameter::Listener
+    {
+    public:
+        explicit OscFeedbackSender(const StateSerializer& layout);
+        ~OscFeedbackSender() override;
+
+        bool connect(const juce::String& targetHost, int port);
+        void disconnect();
+
+        void setRate(double flushesPerSecond);       // Default 60 Hz
+        void setMaxMessagesPerBundle(int maxMessages); // Keeps bundles inside one UDP datagram
+
+        void markAllDirty(); // e.g. a controller just connected and needs the full state
+        
+        // Engine status, sent as /deepmind/status/quality_tier <int> (safe from the audio thread)
+        void setQualityTier(int tier);
+
+        // Counters (for the UI / benchmarks)
+        int getPacketsSent() const { return packetsSent.load(); }
+        int getMessagesSent() const { return messagesSent.load(); }
+
+    private:
+        void run() override;
+        void flush();
+        bool sendBundle(juce::OSCBundle& bundle);
+
+        // AudioProcessorParameter::Listener (any thread)
+        void parameterValueChanged(int parameterIndex, float newValue) override;
+        void parameterGestureChanged(int, bool) override {}
+
+        // Layout order, resolved once (the parameters outlive the StateSerializer)
+        std::vector<juce::AudioProcessorParameter*> parameters;
+        std::vector<juce::OSCAddressPattern> addresses;
+        std::vector<int> processorToLayout;    // AudioProcessor parameter index -> layout index
+
+        static constexpr int bitsPerWord = 64;
+        std::unique_ptr<std::atomic<juce::uint64>[]> dirty;
+        int numDirtyWords = 0;
+
+        juce::CriticalSection senderLock; // connect/disconnect (and the thread start) vs flush
+        juce::OSCSender sender;
+        bool connected = false;
+
+        std::atomic<int> qualityTier { 0 };
+        std::atomic<bool> qualityTierDirty { true };
+
+        std::atomic<int> flushIntervalMs { 16 };
+        std::atomic<int> maxMessagesPerBundle { 32 };
+        std::atomic<int> packetsSent { 0 };
+        std::atomic<int> messagesSent { 0 };
+    };
+}
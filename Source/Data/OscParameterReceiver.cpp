@@ -0,0 +1,164 @@
+#include "OscParameterReceiver.h"
+#include <algorithm>
+
+namespace data
+{
+    OscParameterReceiver::OscParameterReceiver(const StateSerializer& layout)
+    {
+        // Resolve every address once; the network thread only does a hash lookup
+        for (int i = 0; i < layout.getNumParameters(); ++i)
+            addressToIndex.set("/deepmind/" + layout.getParameterID(i), i);
+
+        queue.resize((size_t)queueCapacity);
+        bundleScratch.reserve((size_t)queueCapacity);
+        scheduled.reserve((size_t)queueCapacity);
+        blockEvents.reserve((size_t)queueCapacity);
+
+        receiver.addListener(this);
+    }
+
+    OscParameterReceiver::~OscParameterReceiver()
+    {
+        receiver.removeListener(this);
+        receiver.disconnect();
+    }
+
+    bool OscParameterReceiver::connect(int port)
+    {
+        return receiver.connect(port);
+    }
+
+    void OscParameterReceiver::disconnect()
+    {
+        receiver.disconnect();
+    }
+
+    //==============================================================================
+    // Network thread
+
+    bool OscParameterReceiver::resolve(const juce::OSCMessage& message, double timeMs, Event& event) const
+    {
+        if (message.isEmpty()) return false;
+
+        const auto& arg = message[0];
+        float value = 0.0f;
+        if (arg.isFloat32())    value = arg.getFloat32();
+        else if (arg.isInt32()) value = (float)arg.getInt32();
+        else return false;
+
+        auto address = message.getAddressPattern().toString();
+        if (!addressToIndex.contains(address)) return false;
+
+        event = { addressToIndex[address], juce::jlimit(0.0f, 1.0f, value), timeMs, 0 };
+        return true;
+    }
+
+    void OscParameterReceiver::oscMessageReceived(const juce::OSCMessage& message)
+    {
+        Event event;
+        if (resolve(message, juce::Time::getMillisecondCounterHiRes(), event))
+            push(&event, 1);
+        else if (onControlMessage != nullptr)
+            onControlMessage(message);
+    }
+
+    void OscParameterReceiver::oscBundleReceived(const juce::OSCBundle& bundle)
+    {
+        bundleScratch.clear();
+        collect(bundle, juce::Time::getMillisecondCounterHiRes());
+        push(bundleScratch.data(), (int)bundleScratch.size());
+    }
+
+    void OscParameterReceiver::collect(const juce::OSCBundle& bundle, double timeMs)
+    {
+        // Time-tagged bundles take effect at their tag (converted to the local counter)
+        auto tag = bundle.getTimeTag();
+        if (!tag.isImmediately())
+        {
+            auto delta = (double)(tag.toTime().toMilliseconds() - juce::Time::currentTimeMillis());
+            timeMs = juce::Time::getMillisecondCounterHiRes() + juce::jmax(0.0, delta);
+        }
+
+        for (const auto& element : bundle)
+        {
+            if (bundleScratch.size() >= (size_t)queueCapacity) return;
+
+            Event event;
+            if (element.isBundle())
+                collect(element.getBundle(), timeMs);
+            else if (resolve(element.getMessage(), timeMs, event))
+                bundleScratch.push_back(event);
+            else if (onControlMessage != nullptr)
+                onControlMessage(element.getMessage());
+        }
+    }
+
+    void OscParameterReceiver::push(const Event* events, int count)
+    {
+        if (count <= 0) return;
+
+        // All or nothing: a bundle never arrives half-applied
+        if (fifo.getFreeSpace() < count)
+        {
+            dropped.fetch_add(count);
+            return;
+        }
+
+        const auto scope = fifo.write(count);
+        std::copy(events, events + scope.blockSize1, queue.begin() + scope.startIndex1);
+        std::copy(events + scope.blockSize1, events + count, queue.begin() + scope.startIndex2);
+    }
+
+    //==============================================================================
+    // Audio thread
+
+    void OscParameterReceiver::prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        scheduled.clear();
+        blockEvents.clear();
+    }
+
+    int OscParameterReceiver::popBlockEvents(int numSamples)
+    {
+        // Drain the FIFO into reserved storage (no allocation on this thread)
+        {
+            int room = (int)scheduled.capacity() - (int)scheduled.size();
+            const auto scope = fifo.read(juce::jmin(fifo.getNumReady(), room));
+            auto first = queue.begin();
+            scheduled.insert(scheduled.end(), first + scope.startIndex1, first + scope.startIndex1 + scope.blockSize1);
+            scheduled.insert(scheduled.end(), first + scope.startIndex2, first + scope.startIndex2 + scope.blockSize2);
+        }
+
+        blockEvents.clear();
+        if (scheduled.empty() || numSamples <= 0) return 0;
+
+        // This block renders the time span of the previous one
+        const double blockMs = numSamples * 1000.0 / sampleRate;
+        const double endMs = juce::Time::getMillisecondCounterHiRes();
+        const double startMs = endMs - blockMs;
+
+        // Move due events out, keep the rest in order
+        size_t kept = 0;
+        for (size_t i = 0; i < scheduled.size(); ++i)
+        {
+            Event event = scheduled[i];
+            if (event.timeMs >= endMs)
+            {
+                scheduled[kept++] = event;
+                continue;
+            }
+
+            event.sampleOffset = juce::jlimit(0, numSamples - 1, (int)((event.timeMs - startMs) * sampleRate / 1000.0));
+
+            // Insertion sort by offset. Arrival order is almost sorted already and
+            // equal offsets keep network order, so bundles stay together.
+            blockEvents.push_back(event);
+            for (size_t j = blockEvents.size() - 1; j > 0 && blockEvents[j - 1].sampleOffset > event.sampleOffset; --j)
+                std::swap(blockEvents[j], blockEvents[j - 1]);
+        }
+        scheduled.resize(kept);
+
+        return (int)blockEvents.size();
+    }
+}
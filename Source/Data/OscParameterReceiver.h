@@ -0,0 +1,78 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <functional>
+#include <vector>
+#include "StateSerializer.h"
+
+namespace data
+{
+    // OSC parameter input (/deepmind/{param_id} <float 0..1>).
+    // Addresses are resolved to parameter indices once, up front. The network thread
+    // pushes (index, value, time) into a bounded single-producer/single-consumer FIFO
+    // and the audio thread drains it at the start of each block, giving every event a
+    // sample offset so processBlock can apply it at the right point in the block.
+    // Like mapped CCs, they only change the live values there (StateSerializer::
+    // setLiveValue); the parameters, and so the host and the UI, follow from the
+    // message thread.
+    //
+    // Events are placed one block late (arrival time -> offset in the previous block's
+    // time span), which trades one block of latency for jitter-free timing.
+    // Bundles are queued all-or-nothing and share one timestamp, so their parameters
+    // always change together.
+    //
+    // Messages that aren't parameters (e.g. /deepmind/feedback) go to onControlMessage,
+    // on the network thread.
+    class OscParameterReceiver : private juce::OSCReceiver::Listener<juce::OSCReceiver::RealtimeCallback>
+    {
+    public:
+        struct Event
+        {
+            int parameterIndex;
+            float value;       // Normalised
+            double timeMs;     // Millisecond counter (hi-res) when it should take effect
+            int sampleOffset;  // Filled in by popBlockEvents
+        };
+
+        explicit OscParameterReceiver(const StateSerializer& layout);
+        ~OscParameterReceiver() override;
+        
+        // Set before connect()
+        std::function<void(const juce::OSCMessage&)> onControlMessage;
+
+        bool connect(int port);
+        void disconnect();
+
+        // Audio thread
+        void prepare(double sampleRate);
+        int popBlockEvents(int numSamples);                 // Returns count, sorted by offset
+        const Event* getBlockEvents() const { return blockEvents.data(); }
+
+        int getDroppedCount() const { return dropped.load(); } // Queue full (e.g. flood)
+
+        static constexpr int queueCapacity = 2048;
+
+    private:
+        void oscMessageReceived(const juce::OSCMessage& message) override;
+        void oscBundleReceived(const juce::OSCBundle& bundle) override;
+
+        // Network thread
+        bool resolve(const juce::OSCMessage& message, double timeMs, Event& event) const;
+        void collect(const juce::OSCBundle& bundle, double timeMs);
+        void push(const Event* events, int count);
+
+        juce::OSCReceiver receiver { "OSC Parameter Receiver" };
+        juce::HashMap<juce::String, int> addressToIndex;
+
+        // SPSC queue: network thread -> audio thread
+        juce::AbstractFifo fifo { queueCapacity };
+        std::vector<Event> queue;
+        std::vector<Event> bundleScratch; // Network thread only
+        std::atomic<int> dropped { 0 };
+
+        // Audio thread
+        std::vector<Event> scheduled;   // Popped, not yet due (time-tagged bundles)
+        std::vector<Event> blockEvents; // Due this block
+        double sampleRate = 44100.0;
+    };
+}
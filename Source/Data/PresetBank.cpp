@@ -0,0 +1,261 @@
+#include "PresetBank.h"
+#include "PresetIndex.h"
+#include <algorithm>
+#include <cstring>
+
+namespace data
+{
+    static_assert(sizeof(PresetBank::BankHeader) == 36, "Bank header must stay 36 bytes");
+    static_assert(sizeof(PresetBank::RecordHeader) == 8, "Record header must stay 8 bytes");
+
+    namespace
+    {
+        juce::uint32 readUint32(const void* p) { return juce::ByteOrder::littleEndianInt(p); }
+
+        float readFloat(const void* p)
+        {
+            auto bits = readUint32(p);
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    }
+
+    bool PresetBank::open(const juce::File& bankFile, const StateSerializer& layout)
+    {
+        close();
+
+        mapping = std::make_unique<juce::MemoryMappedFile>(bankFile, juce::MemoryMappedFile::readOnly);
+        base = static_cast<const char*>(mapping->getData());
+        mappedSize = mapping->getSize();
+
+        if (base == nullptr || mappedSize < sizeof(BankHeader)) { close(); return false; }
+
+        // Field by field: the file is little-endian whatever the host is
+        auto field = [this](int i) { return readUint32(base + (size_t)i * sizeof(juce::uint32)); };
+        header.magic = field(0);
+        header.version = field(1);
+        header.numRecords = field(2);
+        header.numParams = field(3);
+        header.layoutHash = field(4);
+        header.recordSize = field(5);
+        header.recordsOffset = field(6);
+        header.stringsOffset = field(7);
+        header.idsOffset = field(8);
+
+        bool valid = header.magic == magic
+                  && header.version == currentVersion
+                  && header.recordsOffset >= sizeof(BankHeader)
+                  && (size_t)header.recordSize == sizeof(RecordHeader) + (size_t)header.numParams * sizeof(float)
+                  && (size_t)header.recordsOffset + (size_t)header.numRecords * header.recordSize <= header.stringsOffset
+                  && header.stringsOffset < mappedSize
+                  && base[mappedSize - 1] == 0; // String table is terminated
+
+        // The mapped values are handed out as they are only if they need no conversion
+        const bool sameLayout = header.numParams == (juce::uint32)layout.getNumParameters()
+                             && header.layoutHash == layout.getLayoutHash();
+
+        if (valid && (!sameLayout || juce::ByteOrder::isBigEndian()))
+            valid = convertValues(layout);
+
+        if (!valid) { close(); return false; }
+        return true;
+    }
+
+    bool PresetBank::convertValues(const StateSerializer& layout)
+    {
+        const bool sameLayout = header.numParams == (juce::uint32)layout.getNumParameters()
+                             && header.layoutHash == layout.getLayoutHash();
+
+        juce::StringArray storedIDs;
+        if (!sameLayout)
+        {
+            auto offset = header.idsOffset;
+            for (juce::uint32 i = 0; i < header.numParams; ++i)
+            {
+                if (header.stringsOffset + (size_t)offset >= mappedSize) return false;
+
+                auto* id = getString(offset);
+                storedIDs.add(juce::String::fromUTF8(id));
+                offset += (juce::uint32)std::strlen(id) + 1;
+            }
+        }
+
+        convertedStride = layout.getNumParameters();
+        convertedValues.assign((size_t)header.numRecords * (size_t)convertedStride, 0.0f);
+
+        std::vector<float> stored(header.numParams);
+        for (int i = 0; i < size(); ++i)
+        {
+            auto* raw = reinterpret_cast<const char*>(getRecord(i) + 1);
+            for (size_t p = 0; p < stored.size(); ++p)
+                stored[p] = readFloat(raw + p * sizeof(float));
+
+            auto* dest = convertedValues.data() + (size_t)i * (size_t)convertedStride;
+            if (sameLayout)
+                std::copy(stored.begin(), stored.end(), dest);
+            else
+                layout.remapValues(storedIDs, stored.data(), dest);
+        }
+        return true;
+    }
+
+    void PresetBank::close()
+    {
+        header = {};
+        base = nullptr;
+        mappedSize = 0;
+        mapping.reset();
+        convertedValues.clear();
+        convertedStride = 0;
+    }
+
+    const PresetBank::RecordHeader* PresetBank::getRecord(int index) const
+    {
+        if (!isOpen() || index < 0 || index >= (int)header.numRecords) return nullptr;
+        return reinterpret_cast<const RecordHeader*>(base + header.recordsOffset + (size_t)index * header.recordSize);
+    }
+
+    const char* PresetBank::getString(juce::uint32 offset) const
+    {
+        // Offsets outside the table read as empty; open() checked the table is terminated
+        if (header.stringsOffset + (size_t)offset >= mappedSize) return "";
+        return base + header.stringsOffset + offset;
+    }
+
+    const char* PresetBank::getName(int index) const
+    {
+        auto* r = getRecord(index);
+        return r != nullptr ? getString(readUint32(&r->nameOffset)) : "";
+    }
+
+    const char* PresetBank::getCategory(int index) const
+    {
+        auto* r = getRecord(index);
+        return r != nullptr ? getString(readUint32(&r->categoryOffset)) : "";
+    }
+
+    const float* PresetBank::getValues(int index) const
+    {
+        auto* r = getRecord(index);
+        if (r == nullptr) return nullptr;
+
+        if (!convertedValues.empty())
+            return convertedValues.data() + (size_t)index * (size_t)convertedStride;
+
+        return reinterpret_cast<const float*>(r + 1);
+    }
+
+    int PresetBank::findByName(const juce::String& name) const
+    {
+        auto* key = name.toRawUTF8();
+        int lo = 0, hi = size() - 1;
+
+        while (lo <= hi)
+        {
+            int mid = (lo + hi) / 2;
+            int cmp = std::strcmp(getName(mid), key);
+            if (cmp == 0) return mid;
+            if (cmp < 0) lo = mid + 1;
+            else hi = mid - 1;
+        }
+        return -1;
+    }
+
+    bool PresetBank::write(const juce::File& bankFile, std::vector<Preset> presets, const StateSerializer& layout)
+    {
+        auto numParams = (juce::uint32)layout.getNumParameters();
+
+        // Sorted by raw UTF-8 bytes so findByName can use strcmp
+        std::sort(presets.begin(), presets.end(), [](const Preset& a, const Preset& b) {
+            return std::strcmp(a.name.toRawUTF8(), b.name.toRawUTF8()) < 0;
+        });
+
+        // String table
+        juce::MemoryOutputStream strings;
+        auto addString = [&](const juce::String& text) {
+            auto offset = (juce::uint32)strings.getDataSize();
+            strings.writeString(text); // Null-terminated UTF-8
+            return offset;
+        };
+
+        // Parameter IDs first, so a later layout can still match values by ID
+        BankHeader h {};
+        h.idsOffset = (juce::uint32)strings.getDataSize();
+        for (int i = 0; i < (int)numParams; ++i)
+            addString(layout.getParameterID(i));
+
+        h.magic = magic;
+        h.version = currentVersion;
+        h.numRecords = (juce::uint32)presets.size();
+        h.numParams = numParams;
+        h.layoutHash = layout.getLayoutHash();
+        h.recordSize = (juce::uint32)(sizeof(RecordHeader) + numParams * sizeof(float));
+        h.recordsOffset = (juce::uint32)sizeof(BankHeader);
+        h.stringsOffset = h.recordsOffset + h.numRecords * h.recordSize;
+
+        // Written field by field (OutputStream is little-endian), not as raw structs
+        juce::MemoryOutputStream out;
+        out.preallocate(h.stringsOffset + presets.size() * 32);
+        for (auto value : { h.magic, h.version, h.numRecords, h.numParams, h.layoutHash,
+                            h.recordSize, h.recordsOffset, h.stringsOffset, h.idsOffset })
+            out.writeInt((int)value);
+
+        for (const auto& p : presets)
+        {
+            out.writeInt((int)addString(p.name));
+            out.writeInt((int)addString(p.category));
+
+            for (juce::uint32 i = 0; i < numParams; ++i)
+                out.writeFloat(i < p.values.size() ? p.values[i] : 0.0f);
+        }
+
+        strings.writeByte(0);
+        out << strings.getMemoryBlock();
+
+        return bankFile.replaceWithData(out.getData(), out.getDataSize());
+    }
+
+    int PresetBank::importFromDirectory(const juce::File& xmlDirectory, const juce::File& bankFile,
+                                        const StateSerializer& layout, const juce::String& rootTag)
+    {
+        std::vector<Preset> presets;
+
+        for (const auto& item : juce::RangedDirectoryIterator(xmlDirectory, false, "*.xml", juce::File::findFiles))
+        {
+            auto xml = juce::XmlDocument::parse(item.getFile());
+            if (xml == nullptr || !xml->hasTagName(rootTag)) continue;
+
+            Preset p;
+            p.name = item.getFile().getFileNameWithoutExtension();
+            p.category = xml->getStringAttribute(PresetIndex::categoryAttribute);
+            p.values.resize((size_t)layout.getNumParameters());
+            layout.valuesFromXml(*xml, p.values.data());
+            presets.push_back(std::move(p));
+        }
+
+        auto count = (int)presets.size();
+        return write(bankFile, std::move(presets), layout) ? count : -1;
+    }
+
+    int PresetBank::exportToDirectory(const juce::File& xmlDirectory, const StateSerializer& layout, const juce::String& rootTag) const
+    {
+        if (!isOpen()) return -1;
+        xmlDirectory.createDirectory();
+
+        int written = 0;
+        for (int i = 0; i < size(); ++i)
+        {
+            auto name = juce::String::fromUTF8(getName(i));
+            auto xml = layout.valuesToXml(getValues(i), rootTag);
+
+            auto category = juce::String::fromUTF8(getCategory(i));
+            if (category.isNotEmpty())
+                xml->setAttribute(PresetIndex::categoryAttribute, category);
+
+            auto file = xmlDirectory.getChildFile(juce::File::createLegalFileName(name)).withFileExtension(".xml");
+            if (xml->writeTo(file)) ++written;
+        }
+        return written;
+    }
+}
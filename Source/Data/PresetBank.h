@@ -0,0 +1,84 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include "StateSerializer.h"
+
+namespace data
+{
+    // Single-file preset bank, read through a memory map.
+    //
+    // Layout (little-endian, all offsets from file start):
+    //   Header  (36 bytes, see BankHeader)
+    //   Records numRecords x recordSize bytes, sorted by name (byte order)
+    //             uint32 nameOffset, uint32 categoryOffset, float values[numParams]
+    //   Strings null-terminated UTF-8; the numParams parameter IDs start at idsOffset
+    //
+    // Lookups by index or name return pointers straight into the mapping, nothing is
+    // parsed or copied. Values use the StateSerializer layout (normalised 0..1).
+    // A bank written with a different parameter layout (or read on a big-endian host)
+    // is converted once in open(): values are matched by parameter ID into a copy.
+    class PresetBank
+    {
+    public:
+        struct BankHeader
+        {
+            juce::uint32 magic;          // 'DMBK'
+            juce::uint32 version;
+            juce::uint32 numRecords;
+            juce::uint32 numParams;
+            juce::uint32 layoutHash;
+            juce::uint32 recordSize;
+            juce::uint32 recordsOffset;
+            juce::uint32 stringsOffset;
+            juce::uint32 idsOffset;      // Into the string table
+        };
+
+        struct RecordHeader
+        {
+            juce::uint32 nameOffset;
+            juce::uint32 categoryOffset;
+            // float values[numParams] follow
+        };
+
+        struct Preset // For writing
+        {
+            juce::String name;
+            juce::String category;
+            std::vector<float> values;
+        };
+
+        static constexpr juce::uint32 magic = 0x4B424D44; // "DMBK"
+        static constexpr juce::uint32 currentVersion = 1;
+
+        // Reading
+        bool open(const juce::File& bankFile, const StateSerializer& layout);
+        void close();
+        bool isOpen() const { return base != nullptr; }
+
+        int size() const { return isOpen() ? (int)header.numRecords : 0; }
+        const char* getName(int index) const;      // UTF-8, inside the mapping
+        const char* getCategory(int index) const;
+        const float* getValues(int index) const;   // numParams floats, inside the mapping
+        int findByName(const juce::String& name) const; // Binary search, -1 if missing
+
+        // Writing / conversion
+        static bool write(const juce::File& bankFile, std::vector<Preset> presets, const StateSerializer& layout);
+        static int importFromDirectory(const juce::File& xmlDirectory, const juce::File& bankFile,
+                                       const StateSerializer& layout, const juce::String& rootTag);
+        int exportToDirectory(const juce::File& xmlDirectory, const StateSerializer& layout, const juce::String& rootTag) const;
+
+    private:
+        const RecordHeader* getRecord(int index) const;
+        const char* getString(juce::uint32 offset) const;
+        bool convertValues(const StateSerializer& layout); // Foreign layout / byte order
+
+        std::unique_ptr<juce::MemoryMappedFile> mapping;
+        BankHeader header {}; // Decoded to host byte order
+        const char* base = nullptr;
+        size_t mappedSize = 0;
+        
+        // Only used when the mapped values can't be handed out as they are
+        std::vector<float> convertedValues; // numRecords x layout.getNumParameters()
+        int convertedStride = 0;
+    };
+}
@@ -0,0 +1,309 @@
+#include "PresetIndex.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace data
+{
+    namespace
+    {
+        constexpr int indexMagic = 0x49504D44; // "DMPI"
+        constexpr int indexVersion = 2; // 2: rejected files appended
+
+        // Smallest possible entry on disk: five empty strings, the time and the fingerprint
+        constexpr int minimumEntryBytes = 5 + 8 + PresetIndex::fingerprintSize;
+        constexpr int minimumRejectedBytes = 1 + 8 + 8;
+        const char* indexFileName = ".presetindex";
+
+        // Parameters that define the 'sound' for similarity lookups
+        const char* fingerprintIds[PresetIndex::fingerprintSize] = {
+            "vcf_freq", "vcf_res", "vcf_env", "vcf_lfo",
+            "vca_attack", "vca_decay", "vca_sustain", "vca_release",
+            "vcf_attack", "vcf_decay", "vcf_sustain", "vcf_release",
+            "dco1_pwm", "dco2_pitch", "lfo1_rate", "unison_detune"
+        };
+
+        // Subsequence match score: higher is better, -1 = no match.
+        // Consecutive and word-start hits score more.
+        int fuzzyScore(const juce::String& text, const juce::String& query)
+        {
+            auto t = text.getCharPointer();
+            int score = 0, run = 0;
+            juce::juce_wchar prev = ' ';
+
+            for (auto q = query.getCharPointer(); !q.isEmpty(); ++q)
+            {
+                bool found = false;
+                while (!t.isEmpty())
+                {
+                    auto c = *t;
+                    ++t;
+                    if (c == *q)
+                    {
+                        ++run;
+                        score += run * 2 + (juce::CharacterFunctions::isLetterOrDigit(prev) ? 0 : 3);
+                        prev = c;
+                        found = true;
+                        break;
+                    }
+                    run = 0;
+                    prev = c;
+                }
+                if (!found) return -1;
+            }
+            return score - text.length() / 8; // Prefer shorter names on ties
+        }
+    }
+
+    PresetIndex::PresetIndex(juce::AudioProcessorValueTreeState& state)
+        : apvts(state)
+    {
+    }
+
+    bool PresetIndex::refresh(const juce::File& presetsDirectory)
+    {
+        auto indexFile = presetsDirectory.getChildFile(indexFileName);
+        bool changed = false;
+
+        if (loadedFrom != presetsDirectory)
+        {
+            entries.clear();
+            rejected.clear();
+            if (!loadIndexFile(indexFile)) changed = true;
+            loadedFrom = presetsDirectory;
+        }
+
+        std::unordered_map<std::string, size_t> known;
+        for (size_t i = 0; i < entries.size(); ++i)
+            known[entries[i].fileName.toStdString()] = i;
+
+        std::unordered_map<std::string, size_t> knownRejected;
+        for (size_t i = 0; i < rejected.size(); ++i)
+            knownRejected[rejected[i].fileName.toStdString()] = i;
+
+        std::vector<Entry> updated;
+        updated.reserve(entries.size());
+        std::vector<Rejected> stillRejected;
+
+        for (const auto& item : juce::RangedDirectoryIterator(presetsDirectory, false, "*.xml", juce::File::findFiles))
+        {
+            auto file = item.getFile();
+            auto fileName = file.getFileNameWithoutExtension();
+            auto mtime = item.getModificationTime().toMilliseconds();
+
+            auto it = known.find(fileName.toStdString());
+            if (it != known.end() && entries[it->second].modificationTime == mtime)
+            {
+                updated.push_back(std::move(entries[it->second])); // Unchanged, no parse
+                continue;
+            }
+
+            auto rejectedIt = knownRejected.find(fileName.toStdString());
+            if (rejectedIt != knownRejected.end()
+                && rejected[rejectedIt->second].modificationTime == mtime
+                && rejected[rejectedIt->second].fileSize == item.getFileSize())
+            {
+                stillRejected.push_back(std::move(rejected[rejectedIt->second])); // Still broken, no parse
+                continue;
+            }
+
+            Entry entry;
+            entry.fileName = fileName;
+            entry.modificationTime = mtime;
+            if (parsePreset(file, entry))
+                updated.push_back(std::move(entry));
+            else
+                stillRejected.push_back({ fileName, mtime, item.getFileSize() });
+            changed = true;
+        }
+
+        // Deletions
+        if (updated.size() != entries.size() || stillRejected.size() != rejected.size()) changed = true;
+        entries = std::move(updated);
+        rejected = std::move(stillRejected);
+
+        if (changed)
+            saveIndexFile(indexFile);
+
+        rebuildLookup();
+        return changed;
+    }
+
+    bool PresetIndex::parsePreset(const juce::File& file, Entry& entry) const
+    {
+        auto xml = juce::XmlDocument::parse(file);
+        if (xml == nullptr || !xml->hasTagName(apvts.state.getType())) return false;
+
+        entry.name = entry.fileName;
+        entry.category = xml->getStringAttribute(categoryAttribute);
+        entry.author = xml->getStringAttribute(authorAttribute);
+        entry.tags.addTokens(xml->getStringAttribute(tagsAttribute), ",", "");
+        entry.tags.trim();
+        entry.tags.removeEmptyStrings();
+
+        for (int i = 0; i < fingerprintSize; ++i)
+        {
+            auto* param = apvts.getParameter(fingerprintIds[i]);
+            if (param == nullptr) continue;
+
+            float norm = param->getDefaultValue();
+            if (auto* child = xml->getChildByAttribute("id", fingerprintIds[i]))
+                norm = param->convertTo0to1((float)child->getDoubleAttribute("value"));
+
+            entry.fingerprint[(size_t)i] = (juce::uint8)juce::roundToInt(juce::jlimit(0.0f, 1.0f, norm) * 255.0f);
+        }
+        return true;
+    }
+
+    bool PresetIndex::loadIndexFile(const juce::File& indexFile)
+    {
+        juce::FileInputStream in(indexFile);
+        if (!in.openedOk()) return false;
+        if (in.readInt() != indexMagic) return false;
+
+        const int version = in.readInt();
+        if (version < 1 || version > indexVersion) return false;
+
+        // The count comes from the file: never reserve more than the file could hold
+        int count = in.readInt();
+        if (count < 0) return false;
+        count = (int)juce::jmin((juce::int64)count, in.getNumBytesRemaining() / minimumEntryBytes);
+        entries.reserve((size_t)count);
+
+        for (int i = 0; i < count && !in.isExhausted(); ++i)
+        {
+            Entry e;
+            e.fileName = in.readString();
+            e.name = in.readString();
+            e.category = in.readString();
+            e.author = in.readString();
+            e.tags.addTokens(in.readString(), ",", "");
+            e.tags.removeEmptyStrings();
+            e.modificationTime = in.readInt64();
+            in.read(e.fingerprint.data(), fingerprintSize);
+            entries.push_back(std::move(e));
+        }
+
+        if (version >= 2 && !in.isExhausted())
+        {
+            int rejectedCount = juce::jmax(0, in.readInt());
+            rejectedCount = (int)juce::jmin((juce::int64)rejectedCount, in.getNumBytesRemaining() / minimumRejectedBytes);
+            rejected.reserve((size_t)rejectedCount);
+
+            for (int i = 0; i < rejectedCount && !in.isExhausted(); ++i)
+            {
+                Rejected r;
+                r.fileName = in.readString();
+                r.modificationTime = in.readInt64();
+                r.fileSize = in.readInt64();
+                rejected.push_back(std::move(r));
+            }
+        }
+        return version == indexVersion; // An older index is rewritten once
+    }
+
+    void PresetIndex::saveIndexFile(const juce::File& indexFile) const
+    {
+        juce::MemoryOutputStream out;
+        out.writeInt(indexMagic);
+        out.writeInt(indexVersion);
+        out.writeInt((int)entries.size());
+        for (const auto& e : entries)
+        {
+            out.writeString(e.fileName);
+            out.writeString(e.name);
+            out.writeString(e.category);
+            out.writeString(e.author);
+            out.writeString(e.tags.joinIntoString(","));
+            out.writeInt64(e.modificationTime);
+            out.write(e.fingerprint.data(), fingerprintSize);
+        }
+
+        out.writeInt((int)rejected.size());
+        for (const auto& r : rejected)
+        {
+            out.writeString(r.fileName);
+            out.writeInt64(r.modificationTime);
+            out.writeInt64(r.fileSize);
+        }
+        indexFile.replaceWithData(out.getData(), out.getDataSize());
+    }
+
+    void PresetIndex::rebuildLookup()
+    {
+        byName.resize(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i) byName[i] = (int)i;
+
+        std::vector<juce::String> lower(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i) lower[i] = entries[i].name.toLowerCase();
+
+        std::sort(byName.begin(), byName.end(), [&](int a, int b) { return lower[(size_t)a] < lower[(size_t)b]; });
+
+        lowerNames.resize(entries.size());
+        for (size_t i = 0; i < byName.size(); ++i) lowerNames[i] = lower[(size_t)byName[i]];
+    }
+
+    std::vector<int> PresetIndex::getAllSortedByName() const
+    {
+        return byName;
+    }
+
+    std::vector<int> PresetIndex::searchPrefix(const juce::String& prefix, int maxResults) const
+    {
+        // Binary search into the sorted lowercase names
+        auto key = prefix.toLowerCase();
+        auto it = std::lower_bound(lowerNames.begin(), lowerNames.end(), key);
+
+        std::vector<int> results;
+        for (; it != lowerNames.end() && (int)results.size() < maxResults && it->startsWith(key); ++it)
+            results.push_back(byName[(size_t)(it - lowerNames.begin())]);
+        return results;
+    }
+
+    std::vector<int> PresetIndex::searchFuzzy(const juce::String& query, int maxResults) const
+    {
+        auto key = query.toLowerCase().removeCharacters(" ");
+        std::vector<std::pair<int, int>> scored; // score, entry
+        
+        for (size_t i = 0; i < lowerNames.size(); ++i)
+        {
+            int score = fuzzyScore(lowerNames[i], key);
+            if (score >= 0) scored.push_back({ score, byName[i] });
+        }
+
+        auto count = juce::jmin((int)scored.size(), maxResults);
+        std::partial_sort(scored.begin(), scored.begin() + count, scored.end(),
+                          [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        std::vector<int> results;
+        for (int i = 0; i < count; ++i) results.push_back(scored[(size_t)i].second);
+        return results;
+    }
+
+    std::vector<int> PresetIndex::findSimilar(int entryIndex, int maxResults) const
+    {
+        if (entryIndex < 0 || entryIndex >= size()) return {};
+        const auto& ref = entries[(size_t)entryIndex].fingerprint;
+
+        // Squared distance over the quantised fingerprint
+        std::vector<std::pair<int, int>> scored; // distance, entry
+        scored.reserve(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            if ((int)i == entryIndex) continue;
+            int dist = 0;
+            for (int k = 0; k < fingerprintSize; ++k)
+            {
+                int d = (int)entries[i].fingerprint[(size_t)k] - (int)ref[(size_t)k];
+                dist += d * d;
+            }
+            scored.push_back({ dist, (int)i });
+        }
+
+        auto count = juce::jmin((int)scored.size(), maxResults);
+        std::partial_sort(scored.begin(), scored.begin() + count, scored.end());
+
+        std::vector<int> results;
+        for (int i = 0; i < count; ++i) results.push_back(scored[(size_t)i].second);
+        return results;
+    }
+}
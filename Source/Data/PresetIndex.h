@@ -0,0 +1,72 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+namespace data
+{
+    // Persistent preset index (one compact binary file in the presets directory).
+    // Holds per-preset metadata plus a small parameter fingerprint so the browser
+    // never has to open preset files to list, search or compare them.
+    // refresh() only re-parses files whose modification time changed. Files that fail
+    // to parse are remembered too (name, time, size) so they aren't retried every time.
+    class PresetIndex
+    {
+    public:
+        static constexpr int fingerprintSize = 16;
+
+        struct Entry
+        {
+            juce::String fileName;   // Without extension, relative to the presets directory
+            juce::String name;
+            juce::String category;
+            juce::String author;
+            juce::StringArray tags;
+            juce::int64 modificationTime = 0;
+            std::array<juce::uint8, fingerprintSize> fingerprint {}; // Quantised key parameters
+        };
+
+        PresetIndex(juce::AudioProcessorValueTreeState& apvts);
+
+        // Load the index file (if any) and sync it with the directory. Returns true if anything changed.
+        bool refresh(const juce::File& presetsDirectory);
+
+        int size() const { return (int)entries.size(); }
+        const Entry& operator[](int index) const { return entries[(size_t)index]; }
+
+        // Queries return entry indices
+        std::vector<int> getAllSortedByName() const;
+        std::vector<int> searchPrefix(const juce::String& prefix, int maxResults = 50) const;
+        std::vector<int> searchFuzzy(const juce::String& query, int maxResults = 50) const;
+        std::vector<int> findSimilar(int entryIndex, int maxResults = 10) const;
+
+        // Metadata attributes written on the preset XML root
+        static constexpr const char* categoryAttribute = "presetCategory";
+        static constexpr const char* authorAttribute = "presetAuthor";
+        static constexpr const char* tagsAttribute = "presetTags";
+
+    private:
+        bool parsePreset(const juce::File& file, Entry& entry) const;
+        bool loadIndexFile(const juce::File& indexFile);
+        void saveIndexFile(const juce::File& indexFile) const;
+        void rebuildLookup();
+
+        juce::AudioProcessorValueTreeState& apvts;
+        std::vector<Entry> entries;
+        
+        // Files that aren't presets of this synth (negative cache)
+        struct Rejected
+        {
+            juce::String fileName;
+            juce::int64 modificationTime = 0;
+            juce::int64 fileSize = 0;
+        };
+        std::vector<Rejected> rejected;
+
+        // Lookup (rebuilt on change)
+        std::vector<int> byName;               // Entry indices sorted by lowercase name
+        std::vector<juce::String> lowerNames;  // Same order as byName
+
+        juce::File loadedFrom;
+    };
+}
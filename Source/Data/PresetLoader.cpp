@@ -0,0 +1,233 @@
+#include "PresetLoader.h"
+#include "PresetManager.h"
+
+namespace data
+{
+    PresetLoader::PresetLoader(juce::AudioProcessorValueTreeState& state, StateSerializer& parameterLayout)
+        : juce::Thread("Preset Loader"), apvts(state), layout(parameterLayout)
+    {
+        presetsDirectory = PresetManager::getDefaultPresetsDirectory();
+        startThread();
+        startTimer(100);
+    }
+
+    PresetLoader::~PresetLoader()
+    {
+        stopTimer();
+        stopThread(2000);
+        delete pending.exchange(nullptr);
+        releaseRetired();
+    }
+
+    void PresetLoader::setPresetsDirectory(const juce::File& directory)
+    {
+        {
+            const juce::ScopedLock sl(requestLock);
+            presetsDirectory = directory;
+        }
+        rescanPrograms();
+    }
+
+    void PresetLoader::rescanPrograms()
+    {
+        programsStale.store(true);
+        notify();
+    }
+
+    juce::String PresetLoader::getProgramName(int programIndex) const
+    {
+        const juce::ScopedLock sl(programLock);
+        return programNames[programIndex];
+    }
+
+    void PresetLoader::loadAsync(const juce::File& file)
+    {
+        {
+            const juce::ScopedLock sl(requestLock);
+            requestedFile = file;
+        }
+        notify();
+    }
+
+    void PresetLoader::loadValuesAsync(std::vector<float> values, const juce::String& name)
+    {
+        auto snapshot = std::make_unique<Snapshot>();
+        snapshot->values = std::move(values);
+        snapshot->name = name;
+        {
+            const juce::ScopedLock sl(requestLock);
+            requestedValues = std::move(snapshot);
+        }
+        notify();
+    }
+
+    void PresetLoader::requestProgram(int programIndex)
+    {
+        // Picked up by the worker's poll, no signalling from the audio thread
+        requestedProgram.store(programIndex);
+    }
+
+    //==============================================================================
+    // Worker
+
+    void PresetLoader::run()
+    {
+        while (!threadShouldExit())
+        {
+            wait(20);
+            releaseRetired();
+
+            juce::File file;
+            std::unique_ptr<Snapshot> values;
+            juce::File directory;
+            {
+                const juce::ScopedLock sl(requestLock);
+                file = std::exchange(requestedFile, juce::File());
+                values = std::move(requestedValues);
+                directory = presetsDirectory;
+            }
+
+            // Program change -> Nth preset in name order, from the index (incremental,
+            // only new or modified presets are parsed)
+            int program = requestedProgram.exchange(-1);
+            if (programsStale.exchange(false) || program >= 0)
+                updatePrograms(directory);
+
+            if (program >= 0 && program < programFiles.size())
+            {
+                file = programFiles[program];
+                currentProgram.store(program);
+            }
+
+            if (file != juce::File())
+            {
+                if (auto* snapshot = parsePreset(file))
+                    publish(snapshot);
+            }
+            else if (values != nullptr && (int)values->values.size() == layout.getNumParameters())
+            {
+                publish(values.release());
+            }
+        }
+    }
+
+    void PresetLoader::updatePrograms(const juce::File& directory)
+    {
+        if (!directory.isDirectory()) return;
+
+        const bool changed = programIndex.refresh(directory);
+        if (!changed && programFiles.size() == programIndex.size()) return;
+
+        juce::Array<juce::File> files;
+        juce::StringArray names;
+        for (int entry : programIndex.getAllSortedByName())
+        {
+            files.add(directory.getChildFile(programIndex[entry].fileName).withFileExtension(".xml"));
+            names.add(programIndex[entry].name);
+        }
+
+        programFiles = std::move(files);
+        {
+            const juce::ScopedLock sl(programLock);
+            programNames = std::move(names);
+        }
+        numPrograms.store(programFiles.size());
+        programListChanged.store(true);
+    }
+
+    PresetLoader::Snapshot* PresetLoader::parsePreset(const juce::File& file) const
+    {
+        if (!file.existsAsFile()) return nullptr;
+
+        auto xml = juce::XmlDocument::parse(file);
+        if (xml == nullptr || !xml->hasTagName(apvts.state.getType())) return nullptr;
+
+        // Full snapshot: parameters missing from the file fall back to their defaults
+        auto snapshot = std::make_unique<Snapshot>();
+        snapshot->name = file.getFileNameWithoutExtension();
+        snapshot->values.resize((size_t)layout.getNumParameters());
+        layout.valuesFromXml(*xml, snapshot->values.data());
+
+        return snapshot.release();
+    }
+
+    void PresetLoader::publish(Snapshot* snapshot)
+    {
+        // A snapshot the audio thread has not taken yet is superseded and ours to delete
+        delete pending.exchange(snapshot);
+    }
+
+    void PresetLoader::releaseRetired()
+    {
+        const auto scope = retireFifo.read(retireFifo.getNumReady());
+        for (int i = 0; i < scope.blockSize1; ++i) delete retireSlots[scope.startIndex1 + i];
+        for (int i = 0; i < scope.blockSize2; ++i) delete retireSlots[scope.startIndex2 + i];
+    }
+
+    void PresetLoader::retire(Snapshot* snapshot)
+    {
+        const auto scope = retireFifo.write(1);
+        if (scope.blockSize1 > 0) retireSlots[scope.startIndex1] = snapshot;
+        else if (scope.blockSize2 > 0) retireSlots[scope.startIndex2] = snapshot;
+        else jassertfalse; // Worker stalled; leaks one snapshot rather than freeing on the audio thread
+    }
+
+    //==============================================================================
+    // Message thread
+
+    void PresetLoader::timerCallback()
+    {
+        if (programListChanged.exchange(false) && onProgramListChanged != nullptr)
+            onProgramListChanged();
+    }
+
+    //==============================================================================
+    // Audio thread
+
+    void PresetLoader::prepare(double sampleRate)
+    {
+        fadeIn.reset(sampleRate, fadeSeconds);
+        fadeIn.setCurrentAndTargetValue(1.0f);
+        fadeOutSamples = juce::jmax(1, juce::roundToInt(sampleRate * fadeSeconds));
+        swapArmed = false;
+    }
+
+    bool PresetLoader::beginBlock()
+    {
+        if (!swapArmed) return false;
+        swapArmed = false;
+        
+        // The last block ended faded out (endBlock); the new sound comes in from silence
+        fadeIn.setCurrentAndTargetValue(0.0f);
+        fadeIn.setTargetValue(1.0f);
+
+        auto* snapshot = pending.exchange(nullptr);
+        if (snapshot == nullptr) return false;
+        
+        // Live values only; the parameters and the host follow from the message thread
+        const int count = juce::jmin((int)snapshot->values.size(), layout.getNumParameters());
+        for (int i = 0; i < count; ++i)
+            layout.setLiveValue(i, snapshot->values[(size_t)i]);
+        
+        retire(snapshot);
+        return true;
+    }
+
+    void PresetLoader::endBlock(juce::AudioBuffer<float>& buffer)
+    {
+        const int numSamples = buffer.getNumSamples();
+        if (fadeIn.isSmoothing())
+            fadeIn.applyGain(buffer, numSamples);
+
+        // A snapshot is waiting: ramp this block's tail down to silence, so the swap at
+        // the start of the next block has no gap and no discontinuity
+        if (!swapArmed && numSamples > 0 && pending.load() != nullptr)
+        {
+            const int rampSamples = juce::jmin(numSamples, fadeOutSamples);
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                buffer.applyGainRamp(channel, numSamples - rampSamples, rampSamples, 1.0f, 0.0f);
+            
+            swapArmed = true;
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <functional>
+#include <vector>
+#include "StateSerializer.h"
+#include "PresetIndex.h"
+
+namespace data
+{
+    // Background preset loader.
+    // Presets are parsed and validated on a worker thread into a full parameter
+    // snapshot (normalised values, StateSerializer layout). The audio thread picks
+    // the snapshot up with an atomic pointer swap at a block boundary and writes it
+    // straight into the live values; the host, the listeners and the UI catch up from
+    // the message thread afterwards (StateSerializer). The old sound is ramped down
+    // over the last few ms of the block before the swap and the new one ramped up
+    // after it, so the change never waits on another thread and also completes offline.
+    // Nothing on the UI or audio thread waits for file I/O or XML parsing.
+    //
+    // Program changes resolve through a PresetIndex of the presets directory (name
+    // order), which also gives the host the real program count and names.
+    class PresetLoader : private juce::Thread,
+                         private juce::Timer
+    {
+    public:
+        struct Snapshot
+        {
+            std::vector<float> values;
+            juce::String name;
+        };
+
+        PresetLoader(juce::AudioProcessorValueTreeState& apvts, StateSerializer& layout);
+        ~PresetLoader() override;
+
+        void setPresetsDirectory(const juce::File& directory);
+        const StateSerializer& getLayout() const { return layout; }
+
+        // Request a load (any non-audio thread). Newer requests replace older ones.
+        void loadAsync(const juce::File& file);
+        void loadValuesAsync(std::vector<float> values, const juce::String& name);
+
+        // Program change by index into the sorted preset list (audio thread safe)
+        void requestProgram(int programIndex);
+        
+        // Program list (any thread). Rescanned by the worker on start, on a directory
+        // change, on each program request and after rescanPrograms().
+        int getNumPrograms() const { return juce::jmax(1, numPrograms.load()); }
+        int getCurrentProgram() const { return juce::jmax(0, currentProgram.load()); }
+        juce::String getProgramName(int programIndex) const;
+        void rescanPrograms();
+        
+        // Message thread callback
+        std::function<void()> onProgramListChanged;
+
+        // Audio thread
+        void prepare(double sampleRate);
+        bool beginBlock();                              // true = a snapshot was applied (all parameters may have changed)
+        void endBlock(juce::AudioBuffer<float>& buffer); // Fades out before a swap, in after it
+
+    private:
+        void run() override;
+        void timerCallback() override; // Message thread: program list notifications
+        
+        Snapshot* parsePreset(const juce::File& file) const;
+        void publish(Snapshot* snapshot);
+        void updatePrograms(const juce::File& directory); // Worker
+        void releaseRetired();                            // Worker
+        void retire(Snapshot* snapshot); // Audio thread -> worker for deletion
+
+        juce::AudioProcessorValueTreeState& apvts;
+        StateSerializer& layout;
+
+        // Requests (worker side)
+        juce::CriticalSection requestLock;
+        juce::File requestedFile;
+        std::unique_ptr<Snapshot> requestedValues;
+        std::atomic<int> requestedProgram { -1 };
+        std::atomic<bool> programsStale { true };
+        juce::File presetsDirectory;
+        
+        // Program list (worker writes, any thread reads under programLock)
+        PresetIndex programIndex { apvts }; // Worker only
+        juce::Array<juce::File> programFiles; // Worker only
+        mutable juce::CriticalSection programLock;
+        juce::StringArray programNames;
+        std::atomic<int> numPrograms { 0 };
+        std::atomic<int> currentProgram { -1 };
+        std::atomic<bool> programListChanged { false };
+
+        // Hand-over
+        std::atomic<Snapshot*> pending { nullptr };
+
+        static constexpr int retireCapacity = 16;
+        juce::AbstractFifo retireFifo { retireCapacity };
+        Snapshot* retireSlots[retireCapacity] = {};
+
+        // Audio thread fade state
+        juce::SmoothedValue<float> fadeIn { 1.0f };
+        int fadeOutSamples = 0;
+        bool swapArmed = false; // Faded out at the end of the last block, swap at the next
+        static constexpr double fadeSeconds = 0.003; // 3ms out + 3ms in
+    };
+}
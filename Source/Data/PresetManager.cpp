@@ -2,27 +2,45 @@
 
 namespace data
 {
-    PresetManager::PresetManager(juce::AudioProcessorValueTreeState& state)
-        : apvts(state)
+    PresetManager::PresetManager(juce::AudioProcessorValueTreeState& state, PresetLoader* presetLoader)
+        : apvts(state), loader(presetLoader)
     {
-        // Default location: User Documents/DeepMindSynth/Presets
-        auto docs = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory);
-        defaultDirectory = docs.getChildFile("DeepMindSynth").getChildFile("Presets");
+        defaultDirectory = getDefaultPresetsDirectory();
         
         if (!defaultDirectory.exists())
             defaultDirectory.createDirectory();
     }
 
-    void PresetManager::savePreset(const juce::String& name)
+    void PresetManager::savePreset(const juce::String& name, const juce::String& category,
+                                   const juce::String& author, const juce::StringArray& tags)
     {
         auto file = defaultDirectory.getChildFile(name).withFileExtension(".xml");
         auto state = apvts.copyState();
         std::unique_ptr<juce::XmlElement> xml(state.createXml());
+        
+        // Browser metadata (read by PresetIndex)
+        if (category.isNotEmpty()) xml->setAttribute(PresetIndex::categoryAttribute, category);
+        if (author.isNotEmpty())   xml->setAttribute(PresetIndex::authorAttribute, author);
+        if (!tags.isEmpty())       xml->setAttribute(PresetIndex::tagsAttribute, tags.joinIntoString(","));
+        
         xml->writeTo(file);
     }
 
+    juce::File PresetManager::getDefaultPresetsDirectory()
+    {
+        // Default location: User Documents/DeepMindSynth/Presets
+        auto docs = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory);
+        return docs.getChildFile("DeepMindSynth").getChildFile("Presets");
+    }
+
     void PresetManager::loadPreset(const juce::File& file)
     {
+        if (loader != nullptr)
+        {
+            loader->loadAsync(file);
+            return;
+        }
+        
         if (file.existsAsFile())
         {
             auto xml = juce::XmlDocument::parse(file);
@@ -38,12 +56,57 @@ namespace data
         return defaultDirectory;
     }
 
-    juce::StringArray PresetManager::findPresets() const
+    juce::StringArray PresetManager::findPresets()
+    {
+        // Incremental: only presets with a new modification time are parsed
+        refreshIndex();
+        return toFileNames(index.getAllSortedByName());
+    }
+
+    void PresetManager::refreshIndex()
+    {
+        index.refresh(defaultDirectory);
+    }
+
+    juce::StringArray PresetManager::searchPresets(const juce::String& query, bool fuzzy) const
+    {
+        return toFileNames(fuzzy ? index.searchFuzzy(query) : index.searchPrefix(query));
+    }
+
+    juce::StringArray PresetManager::findSimilarPresets(const juce::String& fileName, int maxResults) const
+    {
+        for (int i = 0; i < index.size(); ++i)
+            if (index[i].fileName == fileName)
+                return toFileNames(index.findSimilar(i, maxResults));
+        return {};
+    }
+
+    bool PresetManager::openBank(const juce::File& bankFile)
+    {
+        return loader != nullptr && bank.open(bankFile, loader->getLayout());
+    }
+
+    void PresetManager::loadBankPreset(int bankIndex)
+    {
+        auto* values = bank.getValues(bankIndex);
+        if (loader == nullptr || values == nullptr) return;
+
+        auto numParams = loader->getLayout().getNumParameters();
+        loader->loadValuesAsync(std::vector<float>(values, values + numParams), juce::String::fromUTF8(bank.getName(bankIndex)));
+    }
+
+    bool PresetManager::exportDirectoryToBank(const juce::File& bankFile) const
+    {
+        if (loader == nullptr) return false;
+        return PresetBank::importFromDirectory(defaultDirectory, bankFile, loader->getLayout(), apvts.state.getType().toString()) >= 0;
+    }
+
+    juce::StringArray PresetManager::toFileNames(const std::vector<int>& entries) const
     {
         juce::StringArray results;
-        auto files = defaultDirectory.findChildFiles(juce::File::findFiles, false, "*.xml");
-        for (const auto& f : files)
-            results.add(f.getFileNameWithoutExtension());
+        results.ensureStorageAllocated((int)entries.size());
+        for (auto i : entries)
+            results.add(index[i].fileName);
         return results;
     }
 }
@@ -1,21 +1,44 @@
 #pragma once
 #include <JuceHeader.h>
+#include "PresetLoader.h"
+#include "PresetIndex.h"
+#include "PresetBank.h"
 
 namespace data
 {
     class PresetManager
     {
     public:
-        PresetManager(juce::AudioProcessorValueTreeState& apvts);
+        // With a loader, loadPreset() is asynchronous (parsed off-thread, swapped in at a block boundary)
+        PresetManager(juce::AudioProcessorValueTreeState& apvts, PresetLoader* loader = nullptr);
 
-        void savePreset(const juce::String& name);
+        void savePreset(const juce::String& name, const juce::String& category = {},
+                        const juce::String& author = {}, const juce::StringArray& tags = {});
         void loadPreset(const juce::File& file);
         
         juce::File getPresetsDirectory() const;
-        juce::StringArray findPresets() const; // Returns list of file names
+        static juce::File getDefaultPresetsDirectory();
+        juce::StringArray findPresets(); // Returns list of file names (sorted, from the index)
+        
+        // Index queries (call findPresets() or refreshIndex() first), return file names
+        void refreshIndex();
+        juce::StringArray searchPresets(const juce::String& query, bool fuzzy = false) const;
+        juce::StringArray findSimilarPresets(const juce::String& fileName, int maxResults = 10) const;
+        const PresetIndex& getIndex() const { return index; }
+        
+        // Bank files (single memory-mapped file, needs the async loader for the parameter layout)
+        bool openBank(const juce::File& bankFile);
+        void loadBankPreset(int bankIndex);
+        bool exportDirectoryToBank(const juce::File& bankFile) const;
+        const PresetBank& getBank() const { return bank; }
 
     private:
         juce::AudioProcessorValueTreeState& apvts;
+        PresetLoader* loader = nullptr;
         juce::File defaultDirectory;
+        PresetIndex index { apvts };
+        PresetBank bank;
+        
+        juce::StringArray toFileNames(const std::vector<int>& entries) const;
     };
 }
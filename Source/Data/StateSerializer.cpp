@@ -0,0 +1,280 @@
+#include "StateSerializer.h"
+
+namespace data
+{
+    namespace
+    {
+        juce::uint32 hashString(juce::uint32 hash, const juce::String& text)
+        {
+            for (auto* c = text.toRawUTF8(); *c != 0; ++c)
+            {
+                hash ^= (juce::uint8)*c;
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+    }
+
+    StateSerializer::StateSerializer(juce::AudioProcessor& processor)
+    {
+        // Snapshot the layout once. Parameter order is creation order of the layout.
+        layoutHash = 2166136261u;
+        for (auto* param : processor.getParameters())
+        {
+            if (auto* withId = dynamic_cast<juce::AudioProcessorParameterWithID*>(param))
+            {
+                parameters.push_back(param);
+                rangedParameters.push_back(dynamic_cast<juce::RangedAudioParameter*>(param));
+                parameterIDs.add(withId->paramID);
+                layoutHash = hashString(layoutHash, withId->paramID);
+            }
+        }
+        
+        const int numParams = (int)parameters.size();
+        liveValues.reset(new std::atomic<float>[(size_t)juce::jmax(1, numParams)]);
+        pendingValues.reset(new std::atomic<float>[(size_t)juce::jmax(1, numParams)]);
+        numPendingWords = (numParams + bitsPerWord - 1) / bitsPerWord;
+        pending.reset(new std::atomic<juce::uint64>[(size_t)juce::jmax(1, numPendingWords)]);
+        for (int w = 0; w < numPendingWords; ++w)
+            pending[(size_t)w].store(0);
+        
+        for (int i = 0; i < numParams; ++i)
+        {
+            auto* param = parameters[(size_t)i];
+            liveValues[(size_t)i].store(convertFrom0to1(i, param->getValue()));
+            pendingValues[(size_t)i].store(param->getValue());
+            
+            int processorIndex = param->getParameterIndex();
+            if (processorIndex >= (int)processorToLayout.size())
+                processorToLayout.resize((size_t)processorIndex + 1, -1);
+            processorToLayout[(size_t)processorIndex] = i;
+            
+            param->addListener(this);
+        }
+        
+        startTimer(10);
+    }
+
+    StateSerializer::~StateSerializer()
+    {
+        stopTimer();
+        for (auto* param : parameters)
+            param->removeListener(this);
+    }
+
+    void StateSerializer::write(juce::MemoryBlock& dest, const juce::ValueTree& extras) const
+    {
+        juce::MemoryOutputStream out(dest, false);
+        out.writeInt((int)magic);
+        out.writeInt((int)currentVersion);
+        out.writeInt((int)parameters.size());
+        out.writeInt((int)layoutHash);
+        
+        for (auto* p : parameters)
+            out.writeFloat(p->getValue());
+        
+        for (auto& id : parameterIDs)
+            out.writeString(id);
+        
+        if (extras.isValid())
+            extras.writeToStream(out);
+    }
+
+    bool StateSerializer::isBinaryState(const void* data, int sizeInBytes)
+    {
+        if (data == nullptr || sizeInBytes < headerSize) return false;
+        return juce::ByteOrder::littleEndianInt(data) == magic;
+    }
+
+    bool StateSerializer::read(const void* data, int sizeInBytes, juce::ValueTree* extras)
+    {
+        if (!isBinaryState(data, sizeInBytes)) return false;
+
+        juce::MemoryInputStream in(data, (size_t)sizeInBytes, false);
+        in.readInt(); // Magic
+        auto version = (juce::uint32)in.readInt();
+        auto numStored = in.readInt();
+        auto storedHash = (juce::uint32)in.readInt();
+
+        // Written by a newer build, or truncated
+        if (version > currentVersion || numStored < 0) return false;
+        if (in.getNumBytesRemaining() < (juce::int64)numStored * (juce::int64)sizeof(float)) return false;
+
+        std::vector<float> values((size_t)numStored);
+        for (auto& v : values)
+            v = in.readFloat();
+
+        juce::StringArray storedIDs;
+        for (int i = 0; i < numStored && !in.isExhausted(); ++i)
+            storedIDs.add(in.readString());
+        
+        if (storedIDs.size() != numStored) storedIDs.clear(); // Truncated table, unusable
+        
+        if (extras != nullptr)
+            *extras = in.isExhausted() ? juce::ValueTree() : juce::ValueTree::readFromStream(in);
+
+        // Upgrade one version at a time
+        for (auto v = version; v < currentVersion; ++v)
+        {
+            auto it = migrations.find(v);
+            if (it == migrations.end()) return false; // No upgrade path
+            it->second(values);
+        }
+
+        if (storedHash != layoutHash || values.size() != parameters.size())
+        {
+            // Different layout: only usable if the state says which value is which
+            if (storedIDs.size() != (int)values.size()) return false;
+            
+            std::vector<float> remapped(parameters.size());
+            remapValues(storedIDs, values.data(), remapped.data());
+            values = std::move(remapped);
+        }
+
+        applyValues(values.data(), (int)values.size());
+        return true;
+    }
+
+    juce::String StateSerializer::getParameterID(int index) const
+    {
+        return parameterIDs[index];
+    }
+
+    int StateSerializer::getParameterIndex(const juce::String& paramID) const
+    {
+        return parameterIDs.indexOf(paramID);
+    }
+
+    float StateSerializer::convertTo0to1(int index, float realValue) const
+    {
+        auto* ranged = rangedParameters[(size_t)index];
+        return ranged != nullptr ? ranged->convertTo0to1(realValue) : juce::jlimit(0.0f, 1.0f, realValue);
+    }
+
+    float StateSerializer::convertFrom0to1(int index, float value) const
+    {
+        auto* ranged = rangedParameters[(size_t)index];
+        return ranged != nullptr ? ranged->convertFrom0to1(value) : value;
+    }
+
+    void StateSerializer::remapValues(const juce::StringArray& storedIDs, const float* stored, float* dest) const
+    {
+        captureDefaults(dest);
+        
+        for (int i = 0; i < storedIDs.size(); ++i)
+        {
+            int index = parameterIDs.indexOf(storedIDs[i]);
+            if (index >= 0)
+                dest[index] = juce::jlimit(0.0f, 1.0f, stored[i]);
+        }
+    }
+
+    void StateSerializer::captureValues(float* dest) const
+    {
+        for (size_t i = 0; i < parameters.size(); ++i)
+            dest[i] = parameters[i]->getValue();
+    }
+
+    void StateSerializer::captureDefaults(float* dest) const
+    {
+        for (size_t i = 0; i < parameters.size(); ++i)
+            dest[i] = parameters[i]->getDefaultValue();
+    }
+
+    void StateSerializer::applyValues(const float* values, int num)
+    {
+        auto count = juce::jmin(num, (int)parameters.size());
+        for (int i = 0; i < count; ++i)
+            applyValue(i, values[i]);
+    }
+
+    void StateSerializer::applyValue(int index, float value)
+    {
+        auto* param = parameters[(size_t)index];
+        value = juce::jlimit(0.0f, 1.0f, value);
+        
+        // Skip unchanged values to avoid needless listener/host traffic
+        if (param->getValue() != value)
+            param->setValueNotifyingHost(value);
+    }
+
+    std::atomic<float>* StateSerializer::getLiveValue(const juce::String& paramID) const
+    {
+        int index = parameterIDs.indexOf(paramID);
+        return index >= 0 ? &liveValues[(size_t)index] : nullptr;
+    }
+
+    void StateSerializer::setLiveValue(int index, float value)
+    {
+        value = juce::jlimit(0.0f, 1.0f, value);
+        liveValues[(size_t)index].store(convertFrom0to1(index, value));
+        pendingValues[(size_t)index].store(value);
+        pending[(size_t)(index / bitsPerWord)].fetch_or((juce::uint64)1 << (index % bitsPerWord));
+    }
+
+    void StateSerializer::parameterValueChanged(int parameterIndex, float newValue)
+    {
+        if (parameterIndex < 0 || parameterIndex >= (int)processorToLayout.size()) return;
+        
+        int index = processorToLayout[(size_t)parameterIndex];
+        if (index < 0) return;
+        
+        // Our own timerCallback catching the parameter up lands here with the value the
+        // live table already has, which isn't a change for the engine
+        auto value = convertFrom0to1(index, newValue);
+        if (liveValues[(size_t)index].exchange(value) != value && onLiveValueChanged != nullptr)
+            onLiveValueChanged(index);
+    }
+
+    void StateSerializer::timerCallback()
+    {
+        for (int w = 0; w < numPendingWords; ++w)
+        {
+            auto bits = pending[(size_t)w].exchange(0);
+            while (bits != 0)
+            {
+                int bit = juce::countNumberOfBits(((bits & (~bits + 1)) - 1)); // Lowest set bit
+                bits &= bits - 1;
+                
+                // Skipped if the host or UI has moved the parameter since (theirs is newer)
+                int index = w * bitsPerWord + bit;
+                auto value = pendingValues[(size_t)index].load();
+                if (liveValues[(size_t)index].load() == convertFrom0to1(index, value))
+                    applyValue(index, value);
+            }
+        }
+    }
+
+    void StateSerializer::valuesFromXml(const juce::XmlElement& xml, float* dest) const
+    {
+        captureDefaults(dest);
+
+        for (auto* child : xml.getChildIterator())
+        {
+            int index = parameterIDs.indexOf(child->getStringAttribute("id"));
+            if (index < 0) continue; // Unknown / removed parameter
+
+            auto* ranged = rangedParameters[(size_t)index];
+            auto value = (float)child->getDoubleAttribute("value");
+            dest[index] = ranged != nullptr ? ranged->convertTo0to1(value) : juce::jlimit(0.0f, 1.0f, value);
+        }
+    }
+
+    std::unique_ptr<juce::XmlElement> StateSerializer::valuesToXml(const float* values, const juce::String& rootTag) const
+    {
+        auto xml = std::make_unique<juce::XmlElement>(rootTag);
+        for (size_t i = 0; i < parameters.size(); ++i)
+        {
+            auto* ranged = rangedParameters[i];
+            auto* child = xml->createNewChildElement("PARAM");
+            child->setAttribute("id", parameterIDs[(int)i]);
+            child->setAttribute("value", ranged != nullptr ? ranged->convertFrom0to1(values[i]) : values[i]);
+        }
+        return xml;
+    }
+
+    void StateSerializer::addMigration(juce::uint32 fromVersion, Migration migration)
+    {
+        migrations[fromVersion] = std::move(migration);
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace data
+{
+    // Compact binary plugin state (replaces the XML dump in get/setStateInformation)
+    //
+    // Layout (little-endian):
+    //   uint32 magic          'DMST'
+    //   uint32 formatVersion  bump when the format or the meaning of stored values changes
+    //   uint32 numParams
+    //   uint32 layoutHash     FNV-1a of all parameter IDs in layout order
+    //   float  values[numParams] (normalised 0..1, parameter layout order)
+    //   char   ids[numParams][]  null-terminated UTF-8 parameter IDs, same order
+    //   ValueTree extras          everything in the APVTS state that isn't a parameter
+    //                             (properties and non-PARAM children; may be empty)
+    //
+    // Data written by an older formatVersion is upgraded step by step through the
+    // registered migrations before it is applied (none yet: version 1 is the first).
+    // If the layout hash differs (parameters added, removed or reordered since), values
+    // are matched to parameters by ID and parameters the state doesn't know get their
+    // defaults.
+    //
+    // Also owns the live parameter values the engine renders with (see setLiveValue).
+    class StateSerializer : private juce::AudioProcessorParameter::Listener,
+                            private juce::Timer
+    {
+    public:
+        static constexpr juce::uint32 magic = 0x54534D44; // "DMST"
+        static constexpr juce::uint32 currentVersion = 1;
+        static constexpr int headerSize = 16;
+
+        // Must be constructed after the processor's parameters exist (i.e. after the APVTS)
+        StateSerializer(juce::AudioProcessor& processor);
+        ~StateSerializer() override;
+
+        // 'extras' is stored as is after the parameters, and read back into *extras
+        void write(juce::MemoryBlock& dest, const juce::ValueTree& extras = {}) const;
+        bool read(const void* data, int sizeInBytes, juce::ValueTree* extras = nullptr); // false = not a (usable) binary state
+
+        static bool isBinaryState(const void* data, int sizeInBytes);
+
+        // Fixed parameter layout
+        int getNumParameters() const { return (int)parameters.size(); }
+        juce::uint32 getLayoutHash() const { return layoutHash; }
+        juce::String getParameterID(int index) const;
+        int getParameterIndex(const juce::String& paramID) const; // -1 if unknown
+        juce::AudioProcessorParameter* getParameter(int index) const { return parameters[(size_t)index]; }
+        float convertTo0to1(int index, float realValue) const;
+        
+        // Values stored under another layout -> this layout, matched by ID (unknown IDs
+        // are dropped, parameters missing from storedIDs get their default)
+        void remapValues(const juce::StringArray& storedIDs, const float* stored, float* dest) const;
+        
+        void captureValues(float* dest) const;             // normalised, layout order
+        void captureDefaults(float* dest) const;           // normalised defaults, layout order
+        void applyValues(const float* values, int num);    // notifies host
+        void applyValue(int index, float value);           // single parameter, notifies host
+        
+        // Live values: each parameter's real value (as getRawParameterValue would give),
+        // kept current by a listener on every parameter. The audio thread reads these, and
+        // writes its own changes (mapped CCs, OSC, presets) with setLiveValue, which runs no
+        // listeners; the parameter itself is set from the message thread shortly after,
+        // which is when the host, the APVTS listeners and the UI hear about it.
+        std::atomic<float>* getLiveValue(const juce::String& paramID) const; // nullptr if unknown
+        void setLiveValue(int index, float value); // Audio thread, normalised
+        
+        // Called when a parameter changes the live value from outside the audio thread
+        // (host automation, UI, state restore). Any thread; set before the first change.
+        std::function<void(int index)> onLiveValueChanged;
+        
+        // Conversion to/from the APVTS XML layout (<PARAM id=".." value=".."/>, real values).
+        // Parameters missing from the XML get their default value.
+        void valuesFromXml(const juce::XmlElement& xml, float* dest) const;
+        std::unique_ptr<juce::XmlElement> valuesToXml(const float* values, const juce::String& rootTag) const;
+
+        // Migration hook: upgrades values written by 'fromVersion' to fromVersion + 1
+        // (in the order they were stored; matching by ID happens afterwards)
+        using Migration = std::function<void(std::vector<float>& values)>;
+        void addMigration(juce::uint32 fromVersion, Migration migration);
+
+    private:
+        // AudioProcessorParameter::Listener (any thread)
+        void parameterValueChanged(int parameterIndex, float newValue) override;
+        void parameterGestureChanged(int, bool) override {}
+        
+        void timerCallback() override; // Message thread: passes setLiveValue changes on
+        float convertFrom0to1(int index, float value) const;
+        
+        std::vector<juce::AudioProcessorParameter*> parameters;
+        std::vector<juce::RangedAudioParameter*> rangedParameters; // nullptr if not ranged
+        juce::StringArray parameterIDs;
+        juce::uint32 layoutHash = 0;
+        std::vector<int> processorToLayout; // AudioProcessor parameter index -> layout index
+        
+        std::unique_ptr<std::atomic<float>[]> liveValues;    // Real values, layout order
+        std::unique_ptr<std::atomic<float>[]> pendingValues; // Normalised, set by the audio thread
+        static constexpr int bitsPerWord = 64;
+        std::unique_ptr<std::atomic<juce::uint64>[]> pending; // Not yet passed to the parameter
+        int numPendingWords = 0;
+        
+        std::map<juce::uint32, Migration> migrations;
+    };
+}
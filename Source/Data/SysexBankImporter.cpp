@@ -0,0 +1,156 @@
+#include "SysexBankImporter.h"
+#include "SysexTranslator.h"
+#include <atomic>
+#include <cstring>
+
+namespace data
+{
+    double SysexBankImporter::FileReport::megabytesPerSecond() const
+    {
+        return milliseconds > 0.0 ? ((double)bytes / (1024.0 * 1024.0)) / (milliseconds / 1000.0) : 0.0;
+    }
+
+    juce::String SysexBankImporter::Result::describe() const
+    {
+        juce::String text;
+        for (const auto& r : reports)
+        {
+            text << r.file.getFileName() << ": "
+                 << r.programs << "/" << r.frames << " programs, "
+                 << juce::String((double)r.bytes / 1024.0, 1) << " KB, "
+                 << juce::String(r.milliseconds, 2) << " ms, "
+                 << juce::String(r.megabytesPerSecond(), 1) << " MB/s\n";
+        }
+        text << "Total: " << (int)presets.size() << " presets in " << juce::String(wallMilliseconds, 1) << " ms\n";
+        text << "Partial import, taken from each program: " << SysexTranslator::getMappedParameterIDs().joinIntoString(", ")
+             << ". Other parameters come from the base values.";
+        return text;
+    }
+
+    SysexBankImporter::SysexBankImporter(const StateSerializer& parameterLayout)
+        : layout(parameterLayout)
+    {
+    }
+
+    SysexBankImporter::Result SysexBankImporter::importFiles(const juce::Array<juce::File>& files, int numThreads, int framesPerJob) const
+    {
+        auto wallStart = juce::Time::getMillisecondCounterHiRes();
+        Result result;
+
+        // 1. Map files and find frames (memchr for F0 / F7, no decoding yet)
+        std::vector<std::unique_ptr<juce::MemoryMappedFile>> mappings;
+        std::vector<Frame> frames;
+
+        for (int f = 0; f < files.size(); ++f)
+        {
+            FileReport report;
+            report.file = files[f];
+
+            auto mapping = std::make_unique<juce::MemoryMappedFile>(files[f], juce::MemoryMappedFile::readOnly);
+            auto* data = static_cast<const juce::uint8*>(mapping->getData());
+            auto size = (int)mapping->getSize();
+            report.bytes = size;
+
+            int pos = 0;
+            while (data != nullptr && pos < size)
+            {
+                auto* start = static_cast<const juce::uint8*>(std::memchr(data + pos, 0xF0, (size_t)(size - pos)));
+                if (start == nullptr) break;
+                int startPos = (int)(start - data);
+
+                auto* end = static_cast<const juce::uint8*>(std::memchr(start, 0xF7, (size_t)(size - startPos)));
+                if (end == nullptr) break; // Truncated last frame
+                int endPos = (int)(end - data);
+
+                frames.push_back({ f, startPos, endPos - startPos + 1 });
+                ++report.frames;
+                pos = endPos + 1;
+            }
+
+            result.reports.push_back(report);
+            mappings.push_back(std::move(mapping));
+        }
+
+        // 2. Decode + map in parallel. Every frame owns its output slot, no locking.
+        std::vector<float> defaults = baseValues;
+        if ((int)defaults.size() != layout.getNumParameters())
+        {
+            defaults.resize((size_t)layout.getNumParameters());
+            layout.captureDefaults(defaults.data());
+        }
+
+        framesPerJob = juce::jmax(1, framesPerJob);
+        const auto chunkSize = (size_t)framesPerJob;
+        const auto numChunks = (frames.size() + chunkSize - 1) / chunkSize;
+
+        std::vector<PresetBank::Preset> slots(frames.size());
+        std::vector<char> converted(frames.size(), 0);
+        std::vector<double> chunkMs(numChunks, 0.0);
+
+        auto runChunk = [&](size_t chunk) {
+            auto chunkStart = juce::Time::getMillisecondCounterHiRes();
+            juce::uint8 program[SysexTranslator::maxProgramSize];
+
+            auto first = chunk * chunkSize;
+            auto last = juce::jmin(frames.size(), first + chunkSize);
+            for (auto i = first; i < last; ++i)
+            {
+                const auto& fr = frames[i];
+                auto* data = static_cast<const juce::uint8*>(mappings[(size_t)fr.fileIndex]->getData()) + fr.offset;
+
+                int bank = -1, prog = -1;
+                int programSize = SysexTranslator::parseProgramFrame(data, fr.size, program, (int)sizeof(program), bank, prog);
+                if (programSize <= 0) continue;
+
+                auto& preset = slots[i];
+                preset.values = defaults;
+                SysexTranslator::mapProgramToParameters(program, programSize, layout, preset.values.data());
+
+                auto stem = files[fr.fileIndex].getFileNameWithoutExtension();
+                preset.name = bank >= 0 ? stem + " " + juce::String::charToString((juce::juce_wchar)('A' + (bank & 7))) + juce::String(prog + 1).paddedLeft('0', 3)
+                                        : stem + " " + juce::String((int)i + 1);
+                preset.category = stem;
+                converted[i] = 1;
+            }
+
+            chunkMs[chunk] = juce::Time::getMillisecondCounterHiRes() - chunkStart;
+        };
+
+        {
+            auto threads = numThreads > 0 ? numThreads : juce::SystemStats::getNumCpus();
+            juce::ThreadPool pool(threads);
+            juce::WaitableEvent done;
+            std::atomic<int> remaining { (int)numChunks };
+
+            for (size_t c = 0; c < numChunks; ++c)
+            {
+                pool.addJob([&, c] {
+                    runChunk(c);
+                    if (--remaining == 0) done.signal();
+                });
+            }
+
+            if (numChunks > 0)
+                done.wait();
+        }
+
+        // 3. Collect in file order; each frame carries an equal share of its chunk's time
+        for (size_t i = 0; i < frames.size(); ++i)
+        {
+            auto chunk = i / chunkSize;
+            auto framesInChunk = juce::jmin(chunkSize, frames.size() - chunk * chunkSize);
+
+            auto& report = result.reports[(size_t)frames[i].fileIndex];
+            report.milliseconds += chunkMs[chunk] / (double)framesInChunk;
+
+            if (converted[i])
+            {
+                ++report.programs;
+                result.presets.push_back(std::move(slots[i]));
+            }
+        }
+
+        result.wallMilliseconds = juce::Time::getMillisecondCounterHiRes() - wallStart;
+        return result;
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include "StateSerializer.h"
+#include "PresetBank.h"
+
+namespace data
+{
+    // Batch converter for DeepMind .syx libraries.
+    // Each file is memory mapped and scanned for F0..F7 frames. The frames are decoded
+    // (8->7 unpack into a fixed stack buffer) and mapped onto our parameter layout in
+    // parallel on a thread pool, in chunks, so one big library file also uses every core.
+    //
+    // The mapping is partial (see SysexTranslator::mapProgramToParameters): imported
+    // presets carry the program's LFO and DCO 1 settings on top of the base values, not
+    // the whole patch. describe() says so in its report. Until the map covers the whole
+    // program this is not offered as a bank converter (PresetManager has no entry for it).
+    class SysexBankImporter
+    {
+    public:
+        struct FileReport
+        {
+            juce::File file;
+            juce::int64 bytes = 0;
+            int frames = 0;
+            int programs = 0;    // Converted
+            double milliseconds = 0.0; // Decode + map time summed over chunks
+
+            double megabytesPerSecond() const;
+        };
+
+        struct Result
+        {
+            std::vector<PresetBank::Preset> presets;
+            std::vector<FileReport> reports;
+            double wallMilliseconds = 0.0;
+
+            juce::String describe() const; // Per-file throughput table + mapped parameters
+        };
+
+        explicit SysexBankImporter(const StateSerializer& layout);
+
+        // Defaults: every core, 64 frames per job
+        Result importFiles(const juce::Array<juce::File>& files, int numThreads = 0, int framesPerJob = 64) const;
+
+        // Parameter values for fields the SysEx does not carry
+        void setBaseValues(std::vector<float> values) { baseValues = std::move(values); }
+
+    private:
+        struct Frame
+        {
+            int fileIndex;
+            int offset;
+            int size;
+        };
+
+        const StateSerializer& layout;
+        std::vector<float> baseValues; // Defaults if empty
+    };
+}
@@ -0,0 +1,206 @@
+#include "SysexCodec.h"
+#include "../DSP/Kernels/Kernels.h"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+ #include <arm_neon.h>
+ #define DEEPMIND_SYSEX_NEON 1
+#elif defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+ #include <immintrin.h>
+ #define DEEPMIND_SYSEX_SSSE3 1
+ #if defined(__GNUC__) || defined(__clang__)
+  #define DEEPMIND_TARGET_SSSE3 __attribute__((target("ssse3")))
+ #else
+  #define DEEPMIND_TARGET_SSSE3
+ #endif
+#endif
+
+namespace data
+{
+    //==============================================================================
+    // Scalar reference
+
+    int SysexCodec::unpackScalar(const juce::uint8* input, int inputSize, juce::uint8* output, int outputCapacity)
+    {
+        int written = 0;
+        int offset = 0;
+        while (offset + 1 < inputSize && written < outputCapacity) // Need at least header + 1
+        {
+            juce::uint8 header = input[offset++];
+
+            int groupSize = juce::jmin(7, inputSize - offset, outputCapacity - written);
+            for (int i = 0; i < groupSize; ++i)
+                output[written++] = (juce::uint8)(input[offset++] | (((header >> i) & 1) << 7));
+        }
+        return written;
+    }
+
+    int SysexCodec::packScalar(const juce::uint8* data, int size, juce::uint8* out, int outCapacity)
+    {
+        if (outCapacity < packedSizeFor(size)) return -1;
+
+        int written = 0;
+        for (int offset = 0; offset < size; offset += 7)
+        {
+            int groupSize = juce::jmin(7, size - offset);
+            juce::uint8 header = 0;
+            for (int i = 0; i < groupSize; ++i)
+                header |= (juce::uint8)(((data[offset + i] >> 7) & 1) << i);
+
+            out[written++] = header;
+            for (int i = 0; i < groupSize; ++i)
+                out[written++] = (juce::uint8)(data[offset + i] & 0x7F);
+        }
+        return written;
+    }
+
+    //==============================================================================
+    // Two groups per step. The 16-byte loads/stores may touch 2 bytes past the
+    // 14 that are used, so the loops keep that much headroom and leave the rest to
+    // the scalar code.
+
+    namespace
+    {
+#if DEEPMIND_SYSEX_SSSE3
+        DEEPMIND_TARGET_SSSE3
+        int unpackSsse3(const juce::uint8* in, int inSize, juce::uint8* out, int outCapacity, int& consumed)
+        {
+            const __m128i broadcast = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 8, 8, 8, 8, 8, 8, 8, 8);
+            const __m128i bitSelect = _mm_setr_epi8(0, 1, 2, 4, 8, 16, 32, 64, 0, 1, 2, 4, 8, 16, 32, 64);
+            const __m128i compact   = _mm_setr_epi8(1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 13, 14, 15, -1, -1);
+            const __m128i msbBit    = _mm_set1_epi8((char)0x80);
+
+            int i = 0, o = 0;
+            for (; i + 16 <= inSize && o + 16 <= outCapacity; i += 16, o += 14)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                __m128i headers = _mm_shuffle_epi8(v, broadcast);
+                __m128i hasMsb = _mm_cmpeq_epi8(_mm_and_si128(headers, bitSelect), bitSelect);
+                __m128i full = _mm_or_si128(v, _mm_and_si128(hasMsb, msbBit)); // Header lanes dropped below
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), _mm_shuffle_epi8(full, compact));
+            }
+            consumed = i;
+            return o;
+        }
+
+        DEEPMIND_TARGET_SSSE3
+        int packSsse3(const juce::uint8* in, int inSize, juce::uint8* out, int& consumed)
+        {
+            const __m128i expand = _mm_setr_epi8(-1, 0, 1, 2, 3, 4, 5, 6, -1, 7, 8, 9, 10, 11, 12, 13);
+            const __m128i low7 = _mm_set1_epi8(0x7F);
+
+            int i = 0, o = 0;
+            for (; i + 16 <= inSize; i += 14, o += 16)
+            {
+                __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), expand);
+                int msbs = _mm_movemask_epi8(v); // Bit k = MSB of lane k, header lanes are 0
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), _mm_and_si128(v, low7));
+                out[o] = (juce::uint8)((msbs >> 1) & 0x7F);
+                out[o + 8] = (juce::uint8)((msbs >> 9) & 0x7F);
+            }
+            consumed = i;
+            return o;
+        }
+#endif
+
+#if DEEPMIND_SYSEX_NEON
+        int unpackNeon(const juce::uint8* in, int inSize, juce::uint8* out, int outCapacity, int& consumed)
+        {
+            static const juce::uint8 broadcastIdx[16] = { 0, 0, 0, 0, 0, 0, 0, 0, 8, 8, 8, 8, 8, 8, 8, 8 };
+            static const juce::uint8 bitSelectIdx[16] = { 0, 1, 2, 4, 8, 16, 32, 64, 0, 1, 2, 4, 8, 16, 32, 64 };
+            static const juce::uint8 compactIdx[16]   = { 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 13, 14, 15, 0xFF, 0xFF };
+
+            const uint8x16_t broadcast = vld1q_u8(broadcastIdx);
+            const uint8x16_t bitSelect = vld1q_u8(bitSelectIdx);
+            const uint8x16_t compact = vld1q_u8(compactIdx);
+            const uint8x16_t msbBit = vdupq_n_u8(0x80);
+
+            int i = 0, o = 0;
+            for (; i + 16 <= inSize && o + 16 <= outCapacity; i += 16, o += 14)
+            {
+                uint8x16_t v = vld1q_u8(in + i);
+                uint8x16_t hasMsb = vtstq_u8(vqtbl1q_u8(v, broadcast), bitSelect);
+                uint8x16_t full = vorrq_u8(v, vandq_u8(hasMsb, msbBit));
+                vst1q_u8(out + o, vqtbl1q_u8(full, compact));
+            }
+            consumed = i;
+            return o;
+        }
+
+        int packNeon(const juce::uint8* in, int inSize, juce::uint8* out, int& consumed)
+        {
+            static const juce::uint8 expandIdx[16] = { 0xFF, 0, 1, 2, 3, 4, 5, 6, 0xFF, 7, 8, 9, 10, 11, 12, 13 };
+            static const juce::uint8 weightIdx[16] = { 0, 1, 2, 4, 8, 16, 32, 64, 0, 1, 2, 4, 8, 16, 32, 64 };
+
+            const uint8x16_t expand = vld1q_u8(expandIdx);
+            const uint8x16_t weights = vld1q_u8(weightIdx);
+            const uint8x16_t low7 = vdupq_n_u8(0x7F);
+            const uint8x16_t msbBit = vdupq_n_u8(0x80);
+
+            int i = 0, o = 0;
+            for (; i + 16 <= inSize; i += 14, o += 16)
+            {
+                uint8x16_t v = vqtbl1q_u8(vld1q_u8(in + i), expand);
+                uint8x16_t bits = vandq_u8(vtstq_u8(v, msbBit), weights); // Header weight per lane
+                vst1q_u8(out + o, vandq_u8(v, low7));
+                out[o] = vaddv_u8(vget_low_u8(bits));
+                out[o + 8] = vaddv_u8(vget_high_u8(bits));
+            }
+            consumed = i;
+            return o;
+        }
+#endif
+    }
+
+    //==============================================================================
+
+    bool SysexCodec::isVectorised()
+    {
+        // Follows the kernel dispatcher, so forcing the scalar kernels
+        // (DeepMindDSP::Kernels::forceIsa / DEEPMIND_ISA) covers this path too
+        using DeepMindDSP::Kernels::Isa;
+        const auto active = DeepMindDSP::Kernels::getActiveIsa();
+
+#if DEEPMIND_SYSEX_NEON
+        return active != Isa::Scalar;
+#elif DEEPMIND_SYSEX_SSSE3
+        static const bool hasSsse3 = juce::SystemStats::hasSSSE3();
+        return hasSsse3 && active != Isa::Scalar;
+#else
+        juce::ignoreUnused(active);
+        return false;
+#endif
+    }
+
+    int SysexCodec::unpack(const juce::uint8* packed, int packedSize, juce::uint8* out, int outCapacity)
+    {
+        int consumed = 0, written = 0;
+
+#if DEEPMIND_SYSEX_NEON
+        if (isVectorised())
+            written = unpackNeon(packed, packedSize, out, outCapacity, consumed);
+#elif DEEPMIND_SYSEX_SSSE3
+        if (isVectorised())
+            written = unpackSsse3(packed, packedSize, out, outCapacity, consumed);
+#endif
+
+        // Tail (and everything on other targets)
+        return written + unpackScalar(packed + consumed, packedSize - consumed, out + written, outCapacity - written);
+    }
+
+    int SysexCodec::pack(const juce::uint8* data, int size, juce::uint8* out, int outCapacity)
+    {
+        if (outCapacity < packedSizeFor(size)) return -1;
+
+        int consumed = 0, written = 0;
+
+#if DEEPMIND_SYSEX_NEON
+        if (isVectorised())
+            written = packNeon(data, size, out, consumed);
+#elif DEEPMIND_SYSEX_SSSE3
+        if (isVectorised())
+            written = packSsse3(data, size, out, consumed);
+#endif
+
+        return written + packScalar(data + consumed, size - consumed, out + written, outCapacity - written);
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <JuceHeader.h>
+
+namespace data
+{
+    // DeepMind 7-bit SysEx packing.
+    // Packed stream = groups of 1 MSB byte + up to 7 data bytes; bit i of the MSB
+    // byte is bit 7 of data byte i. A short final group is allowed.
+    //
+    // unpack()/pack() run two groups (16 <-> 14 bytes) per step with SSSE3 or NEON
+    // shuffles and finish the tail with the scalar reference code.
+    class SysexCodec
+    {
+    public:
+        // 8 -> 7. Returns bytes written (stops early if outCapacity is reached).
+        static int unpack(const juce::uint8* packed, int packedSize, juce::uint8* out, int outCapacity);
+
+        // 7 -> 8. Returns bytes written, or -1 if outCapacity < packedSizeFor(size).
+        static int pack(const juce::uint8* data, int size, juce::uint8* out, int outCapacity);
+
+        static int packedSizeFor(int unpackedSize)
+        {
+            return (unpackedSize / 7) * 8 + (unpackedSize % 7 != 0 ? unpackedSize % 7 + 1 : 0);
+        }
+
+        static int unpackedSizeFor(int packedSize)
+        {
+            return (packedSize / 8) * 7 + juce::jmax(0, packedSize % 8 - 1);
+        }
+
+        // Scalar reference implementations (tail handling, tests, benchmarks)
+        static int unpackScalar(const juce::uint8* packed, int packedSize, juce::uint8* out, int outCapacity);
+        static int packScalar(const juce::uint8* data, int size, juce::uint8* out, int outCapacity);
+
+        static bool isVectorised();
+    };
+}
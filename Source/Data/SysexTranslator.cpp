@@ -1,4 +1,6 @@
 #include "SysexTranslator.h"
+#include "StateSerializer.h"
+#include "SysexCodec.h"
 
 namespace data
 {
@@ -55,37 +57,109 @@ namespace data
         // Packed Format: 8 input bytes -> 7 output bytes.
         // Input Byte 0 is Guidemap.
         // Input Bytes 1-7 are Data (low 7 bits).
+        // "278 7-bit message bytes" matches 242 real bytes. 34 blocks of 8? 34*8 = 272. +6 extra.
         
-        std::vector<int> output;
-        output.reserve(inputSize); // Approx
+        std::vector<juce::uint8> decoded((size_t)juce::jmax(0, inputSize));
+        int count = decodePackedData(input, inputSize, decoded.data(), (int)decoded.size());
+        return std::vector<int>(decoded.begin(), decoded.begin() + count);
+    }
+
+    int SysexTranslator::decodePackedData(const juce::uint8* input, int inputSize, juce::uint8* output, int outputCapacity)
+    {
+        // Bit i of each group header is the MSB of data byte i (SIMD kernel in SysexCodec)
+        return SysexCodec::unpack(input, inputSize, output, outputCapacity);
+    }
+
+    int SysexTranslator::buildProgramFrame(const juce::uint8* program, int programSize,
+                                           int deviceId, int bank, int programNumber,
+                                           juce::uint8* frame, int frameCapacity)
+    {
+        // F0 00 20 32 20 <dev> <type> <proto> [bank prog] <packed...> F7
+        const bool editBuffer = (bank < 0 || programNumber < 0);
+        const int headerSize = editBuffer ? 8 : 10;
+        const int packedSize = SysexCodec::packedSizeFor(programSize);
+        if (frameCapacity < headerSize + packedSize + 1) return -1;
+
+        const juce::uint8 header[] = { 0xF0, 0x00, 0x20, 0x32, 0x20,
+                                       (juce::uint8)(deviceId & 0x0F),
+                                       (juce::uint8)(editBuffer ? 0x04 : 0x02),
+                                       0x06,
+                                       (juce::uint8)(bank & 0x7F),
+                                       (juce::uint8)(programNumber & 0x7F) };
+        std::memcpy(frame, header, (size_t)headerSize);
+
+        SysexCodec::pack(program, programSize, frame + headerSize, packedSize);
+        frame[headerSize + packedSize] = 0xF7;
+        return headerSize + packedSize + 1;
+    }
+
+    int SysexTranslator::parseProgramFrame(const juce::uint8* data, int size,
+                                           juce::uint8* output, int outputCapacity,
+                                           int& bank, int& program)
+    {
+        // Same header rules as parseSysex: F0 00 20 32 20 <dev> <type> <proto> ...
+        if (size < 10 || data[0] != 0xF0) return -1;
+        if (data[1] != 0x00 || data[2] != 0x20 || data[3] != 0x32 || data[4] != 0x20) return -1;
+        
+        juce::uint8 msgType = data[6];
+        int dataStart = 0;
+        if (msgType == 0x02) { dataStart = 10; bank = data[8]; program = data[9]; } // Program Dump
+        else if (msgType == 0x04) { dataStart = 8; bank = -1; program = -1; }   // Edit Buffer
+        else return -1;
         
-        int offset = 0;
-        while (offset + 1 < inputSize) // Need at least header + 1
+        int dataEnd = data[size - 1] == 0xF7 ? size - 1 : size;
+        if (dataEnd <= dataStart) return -1;
+        
+        return decodePackedData(data + dataStart, dataEnd - dataStart, output, outputCapacity);
+    }
+
+    namespace
+    {
+        // DeepMind program byte -> parameter. Discrete fields carry the raw value
+        // (choice index / switch), continuous fields are 0..255 scaled to 0..1.
+        // Add a field here only with its offset checked against a real dump.
+        struct ProgramField
         {
-            // Usually chunks of 8. If less than 8 left, process what we have.
-            // But valid dumps should be multiples of 8 effectively?
-            // "278 7-bit message bytes" matches 242 real bytes. 34 blocks of 8? 34*8 = 272. +6 extra.
+            int offset;
+            const char* paramId;
+            int maxRaw;
+            bool discrete;
+        };
+        
+        const ProgramField programFields[] = {
+            { 0,  "lfo1_rate",     255, false },
+            { 1,  "lfo1_delay",    255, false },
+            { 2,  "lfo1_shape",    6,   true  },
+            { 7,  "lfo2_rate",     255, false },
+            { 8,  "lfo2_delay",    255, false },
+            { 9,  "lfo2_shape",    6,   true  },
+            { 14, "dco1_range",    2,   true  },
+            { 18, "dco1_pulse_en", 1,   true  },
+            { 19, "dco1_saw_en",   1,   true  },
+        };
+    }
+
+    void SysexTranslator::mapProgramToParameters(const juce::uint8* program, int programSize,
+                                                 const StateSerializer& layout, float* values)
+    {
+        for (const auto& field : programFields)
+        {
+            if (field.offset >= programSize) continue;
             
-            juce::uint8 header = input[offset];
-            offset++;
+            int index = layout.getParameterIndex(field.paramId);
+            if (index < 0) continue;
             
-            // Process up to 7 following bytes, or until end
-            for (int i = 0; i < 7; ++i)
-            {
-                if (offset >= inputSize) break;
-                
-                juce::uint8 dataByte = input[offset];
-                offset++;
-                
-                // Reconstruct MSB
-                // Bit i of header is MSB for this data byte
-                bool msb = (header >> i) & 1;
-                
-                int fullValue = dataByte | (msb ? 0x80 : 0x00);
-                output.push_back(fullValue);
-            }
+            int raw = juce::jmin((int)program[field.offset], field.maxRaw);
+            values[index] = field.discrete ? layout.convertTo0to1(index, (float)raw)
+                                           : (float)raw / (float)field.maxRaw;
         }
-        
-        return output;
+    }
+
+    juce::StringArray SysexTranslator::getMappedParameterIDs()
+    {
+        juce::StringArray ids;
+        for (const auto& field : programFields)
+            ids.add(field.paramId);
+        return ids;
     }
 }
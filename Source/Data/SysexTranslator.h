@@ -4,14 +4,42 @@
 
 namespace data
 {
+    class StateSerializer;
+
     class SysexTranslator
     {
     public:
         // Returns empty vector if invalid or not a program dump
         static std::vector<int> parseSysex(const juce::MidiMessage& message);
+        
+        // Raw frame variant (F0 ... F7, no MidiMessage / allocation).
+        // Decodes the program into 'output' and returns the number of bytes, or -1 if the
+        // frame is not a DeepMind program / edit buffer dump. bank/program are -1 for edit buffers.
+        static int parseProgramFrame(const juce::uint8* frame, int frameSize,
+                                     juce::uint8* output, int outputCapacity,
+                                     int& bank, int& program);
+        
+        // 8 -> 7 unpack into a caller-owned span. Returns bytes written.
+        static int decodePackedData(const juce::uint8* input, int inputSize, juce::uint8* output, int outputCapacity);
+        
+        // Inverse of parseProgramFrame: packs a decoded program into a complete frame.
+        // bank/program < 0 builds an edit buffer dump. Returns the frame size, or -1 if it doesn't fit.
+        static int buildProgramFrame(const juce::uint8* program, int programSize,
+                                     int deviceId, int bank, int programNumber,
+                                     juce::uint8* frame, int frameCapacity);
+        
+        // Decoded DeepMind program bytes -> normalised values in the StateSerializer layout.
+        // Partial: only the fields whose program offsets are confirmed are mapped (LFO 1/2
+        // rate, delay and shape; DCO 1 range and waveform switches, see
+        // getMappedParameterIDs). Everything else, including VCF, envelopes, DCO 2, VCA,
+        // mod matrix and FX, keeps whatever 'values' already holds.
+        static void mapProgramToParameters(const juce::uint8* program, int programSize,
+                                           const StateSerializer& layout, float* values);
+        static juce::StringArray getMappedParameterIDs();
+        
+        static constexpr int maxProgramSize = 256; // Decoded DeepMind program is 242 bytes
     
     private:
         static std::vector<int> decodePackedData(const juce::uint8* data, int size);
     };
 }
-
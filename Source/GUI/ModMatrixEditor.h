@@ -59,7 +59,8 @@ private:
             // Source
             addAndMakeVisible(cmbSrc);
             // Populate similar to PluginProcessor (Manual copy for now or shared list)
-            juce::StringArray modSources = { "None", "LFO1", "LFO2", "EnvMod", "Velocity", "ModWheel", "KeyTrack" };
+            juce::StringArray modSources = { "None", "LFO1", "LFO2", "EnvMod", "Velocity", "ModWheel", "KeyTrack",
+                                             "EnvVcf", "EnvVca", "CtrlSeq", "PitchBend", "Pressure", "Timbre" };
             for(int i=0; i<modSources.size(); ++i) cmbSrc.addItem(modSources[i], i+1);
             attSrc = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, prefix + "_src", cmbSrc);
 
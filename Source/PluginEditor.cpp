@@ -27,6 +27,7 @@ DeepMindSynthAudioProcessorEditor::DeepMindSynthAudioProcessorEditor (DeepMindSy
     cmb_vcf_type.addItem("Jupiter 8 (Ladder 24dB)", 1);
     cmb_vcf_type.addItem("MS-20 (SVF + Dist)", 2);
     cmb_vcf_type.addItem("TB-303 (Acid)", 3);
+    cmb_vcf_type.addItem("DeepMind (IR3109 12/24dB)", 4);
     att_vcf_type = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(audioProcessor.apvts, "vcf_type", cmb_vcf_type);
 
     // --- Unison Overlay Controls ---
@@ -318,12 +319,14 @@ void DeepMindSynthAudioProcessorEditor::timerCallback()
     float cpu = audioProcessor.getCpuUsage();
     int lastNote = audioProcessor.lastNoteTriggered.load();
     juce::String txt = "CPU: " + juce::String(cpu, 1) + "%";
+    txt += "  Voices: " + juce::String(audioProcessor.getActiveVoiceCount());
     if (lastNote >= 0) txt += "  Note: " + juce::String(lastNote);
+    if (audioProcessor.getQualityTier() > 0) txt += "  Quality: " + juce::String(audioProcessor.getQualityTierName());
     
     lblCpu.setText(txt, juce::dontSendNotification);
     
     // Color warning
-    if (cpu > 80.0f) lblCpu.setColour(juce::Label::textColourId, juce::Colours::red);
+    if (cpu > 80.0f || audioProcessor.getQualityTier() > 0) lblCpu.setColour(juce::Label::textColourId, juce::Colours::red);
     else if (cpu > 50.0f) lblCpu.setColour(juce::Label::textColourId, juce::Colours::orange);
     else lblCpu.setColour(juce::Label::textColourId, juce::Colours::white);
 }
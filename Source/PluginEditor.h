@@ -96,7 +96,7 @@ private:
     // Presets
     juce::ComboBox cmbPresets;
     juce::TextButton btnSavePreset { "SAVE" };
-    data::PresetManager presetManager { audioProcessor.apvts };
+    data::PresetManager presetManager { audioProcessor.apvts, audioProcessor.presetLoader.get() };
     
     std::unique_ptr<ControlSeqEditor> ctrlSeqEditor;
     
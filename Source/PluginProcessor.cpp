@@ -1,8 +1,11 @@
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+#if ! DEEPMIND_HEADLESS
+ #include "PluginEditor.h"
+#endif
 #include "Data/SysexTranslator.h" 
 #include "Data/MidiManager.h" // Explicit include to fix incomplete type
 #include "Data/DeepMindParameters.h"
+#include "DSP/TraceRecorder.h"
 
 DeepMindSynthAudioProcessor::DeepMindSynthAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -14,30 +17,9 @@ DeepMindSynthAudioProcessor::DeepMindSynthAudioProcessor()
 #endif
 {
 #if JUCE_STANDALONE_APPLICATION
-    // RPi Headless / Kiosk Mode Auto-Connect
-    // Auto-select first available MIDI and Audio devices on startup
-    
-    // Defer slighty to ensure devices are ready? No, constructor is fine usually.
-    // We need to access the StandalonePluginHolder.
-    
-    // Note: This only compiles if we are building the Standalone target source specifically,
-    // or if JUCE_STANDALONE_APPLICATION is defined (which it is for standalone builds).
-    
-    /* 
-       We cannot easily access StandalonePluginHolder instance from here without linking headers 
-       or using magic singletons that might not be init yet.
-       However, we can just use MidiInput::getAvailableDevices() and set it on the *DeviceManager*?
-       Wait, the DeviceManager belongs to the StandaloneFilterWindow... 
-       Actually, standard JUCE AudioProcessor doesn't own the DeviceManager.
-       The Standalone wrapper does.
-       
-       Hack: The user can select it in Options.
-       But for a "It sounded before" fix, maybe we should just ensure logic is correct.
-       The user said "Test works". That suggests Audio driver is fine.
-       If Screen Keyboard doesn't work, MIDI INPUT device is NOT the issue for *Screen Keyboard*.
-       
-       So the issue is likely internal (Arp or processing).
-    */
+    // The JUCE standalone wrapper owns the device manager, so there's no auto-connect
+    // here. Rack units use DeepMindSynthHeadless instead (Headless/), which opens the
+    // devices itself and does the real-time setup (SCHED_FIFO, mlockall, prefaulting).
 #endif
 
     // Hardcoded SysEx load removed in favor of manual import via GUI.
@@ -47,7 +29,7 @@ DeepMindSynthAudioProcessor::DeepMindSynthAudioProcessor()
     // Add voices to synthesiser
     // Add voices to synthesiser (Default to 12)
     for (int i = 0; i < 12; ++i)
-        synthesiser.addVoice(new voice::SynthVoice());
+        synthesiser.addVoice(createVoice());
         
     synthesiser.addSound(new voice::SynthSound());
     
@@ -55,10 +37,57 @@ DeepMindSynthAudioProcessor::DeepMindSynthAudioProcessor()
     
     
     midiManager = std::make_unique<data::MidiManager>(apvts);
-    oscManager = std::make_unique<data::OscManager>(apvts);
-    oscManager->connect(8000); // Port 8000
+    presetLoader = std::make_unique<data::PresetLoader>(apvts, stateSerializer);
+    presetLoader->onProgramListChanged = [this] { updateHostDisplay(ChangeDetails().withProgramChanged(true)); };
+    // OSC: these two replace OscManager for both directions (it would otherwise send
+    // its own feedback alongside). The sender exists before the receiver can ask for it.
+    oscFeedback = std::make_unique<data::OscFeedbackSender>(stateSerializer);
+    oscFeedback->connect("127.0.0.1", defaultOscFeedbackPort); // Port 9000 (TX), 60 Hz bundles
+    oscReceiver = std::make_unique<data::OscParameterReceiver>(stateSerializer);
+    oscReceiver->onControlMessage = [this](const juce::OSCMessage& message) { handleOscControl(message); };
+    oscReceiver->connect(8000); // Port 8000 (RX), lock-free path to the audio thread
+    
+    // MIDI CC -> Parameter (hardcoded mapping from CSV), resolved once
+    const std::pair<int, const char*> ccMapping[] = {
+        { 29, "vcf_freq" },      // VCF Freq
+        { 30, "vcf_res" },       // VCF Reso
+        { 16, "lfo1_rate" },     // LFO1 Rate
+        { 21, "dco1_pwm" },      // OSC1 PWM
+        { 28, "unison_detune" }, // Unison
+        { 10, "pan" },           // Pan
+        { 37, "arp_rate" },      // Arp Rate
+        // ... Add more mappings as needed
+    };
+    ccToParameter.fill(-1);
+    for (const auto& [cc, paramId] : ccMapping)
+        ccToParameter[(size_t)cc] = stateSerializer.getParameterIndex(paramId);
+    
+    // Layout index -> the voice parameter group it feeds, so an event only updates that
+    for (int i = 0; i < stateSerializer.getNumParameters(); ++i)
+        parameterVoiceGroups.push_back(voice::SynthVoice::groupForParameter(stateSerializer.getParameterID(i)));
+    
+    // Host automation / UI: the voices re-read only the groups that changed, next render
+    stateSerializer.onLiveValueChanged = [this](int index) { dirtyVoiceGroups.fetch_or(parameterVoiceGroups[(size_t)index]); };
+    
+    auto get = [this](const juce::String& id) { return stateSerializer.getLiveValue(id); };
+    live.extAudioGain = get("ext_audio_gain");
+    live.arpOn = get("arp_on");
+    live.arpMode = get("arp_mode");
+    live.arpRate = get("arp_rate");
+    live.arpOct = get("arp_oct");
+    live.arpPattern = get("arp_pattern");
+    live.chorusMix = get("fx_chorus_mix");
+    live.chorusRate = get("fx_chorus_rate");
+    live.chorusDepth = get("fx_chorus_depth");
+    live.delayMix = get("fx_delay_mix");
+    live.delayTime = get("fx_delay_time");
+    live.delayFeedback = get("fx_delay_feedback");
+    live.reverbMix = get("fx_reverb_mix");
+    live.reverbSize = get("fx_reverb_size");
+    live.reverbDamp = get("fx_reverb_damp");
     
     apvts.addParameterListener("polyphony_mode", this);
+    apvts.addParameterListener("engine_rate", this);
     // Initial update
     // updatePolyphony(); // Calling virtual/complex methods in constructor is risky? 
     // Just ensure default 12 voices (set in loop above to 8. Update to 12).
@@ -70,19 +99,50 @@ DeepMindSynthAudioProcessor::~DeepMindSynthAudioProcessor()
 
 juce::AudioProcessorValueTreeState::ParameterLayout DeepMindSynthAudioProcessor::createParameterLayout()
 {
-    return DeepMindParams::createParameterLayout();
+    auto layout = DeepMindParams::createParameterLayout();
+    
+    // Engine rate (see setEngineRate). Saved with the session, but not automatable:
+    // a change re-prepares the engine and changes the reported latency.
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID { "engine_rate", 1 }, "Engine Rate",
+        juce::StringArray { "Host", "Standard", "High" }, 0,
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    
+    return layout;
 }
 
 void DeepMindSynthAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    synthesiser.setCurrentPlaybackSampleRate(sampleRate);
+    // Engine (synth + FX) rate: the host rate, or an integer fraction of it
+    const int factor = engineFactorFor(sampleRate, engineRate.load());
+    engineSampleRate = sampleRate / factor;
+    resampler.prepare(factor, getTotalNumOutputChannels(), samplesPerBlock);
+    engineBuffer.setSize(getTotalNumOutputChannels(), resampler.getMaximumInternalBlock());
+    engineMidi.ensureSize(4096);
+    setLatencySamples(resampler.getLatencySamples());
+    
+    synthesiser.setCurrentPlaybackSampleRate(engineSampleRate);
+    dirtyVoiceGroups.store(voice::SynthVoice::allGroups); // Rate-dependent settings
     
     juce::dsp::ProcessSpec spec;
     spec.sampleRate = sampleRate;
     spec.maximumBlockSize = samplesPerBlock;
     spec.numChannels = getTotalNumOutputChannels();
     
-    fxChain.prepare(spec);
+    juce::dsp::ProcessSpec engineSpec = spec;
+    engineSpec.sampleRate = engineSampleRate;
+    engineSpec.maximumBlockSize = (juce::uint32)(factor > 1 ? resampler.getMaximumInternalBlock() : samplesPerBlock);
+    
+    fxChain.prepare(engineSpec);
+    governor.prepare(sampleRate, samplesPerBlock);
+    appliedQualityTier = -1;
+    presetLoader->prepare(sampleRate);
+    oscReceiver->prepare(sampleRate);
+    parameterEvents.reserve((size_t)maxParameterEventsPerBlock);
+    synthesiser.setMinimumRenderingSubdivisionSize(minimumSubBlockSamples, false);
+    fxSilentSamples = 0;
+    fxTailHoldSamples = (int)(sampleRate * fxTailHoldSeconds);
+    engineIdle.store(false);
     arpeggiator.prepare(spec);
     arpeggiator.prepare(spec);
     // arpeggiator.setBypass(false); // DISABLED: Let parameters control bypass (default Off)
@@ -101,25 +161,40 @@ bool DeepMindSynthAudioProcessor::isBusesLayoutSupported (const BusesLayout& lay
 void DeepMindSynthAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    DeepMindDSP::QualityGovernor::ScopedBlock governorTimer(governor, buffer.getNumSamples());
+    DEEPMIND_TRACE_ZONE("processBlock");
+    applyQualityTier();
+    if (voiceSilenceChanged.exchange(false))
+        applyVoiceSilenceThreshold();
+    
+    // 0. Pending preset (applied here once the previous block has faded out)
+    if (presetLoader->beginBlock())
+        dirtyVoiceGroups.fetch_or(voice::SynthVoice::allGroups);
     
     // 1. Handle MIDI Input (Note On/Off handled by synth, CCs by Manager)
     // Debug: Track Last Note
-    for (const auto metadata : midiMessages)
     {
-        if (metadata.getMessage().isNoteOn())
-            lastNoteTriggered = metadata.getMessage().getNoteNumber();
-    }
+        DEEPMIND_TRACE_ZONE("midi");
+        for (const auto metadata : midiMessages)
+        {
+            if (metadata.getMessage().isNoteOn())
+                lastNoteTriggered = metadata.getMessage().getNoteNumber();
+        
+            // Program Change -> background preset load
+            if (metadata.getMessage().isProgramChange())
+                presetLoader->requestProgram(metadata.getMessage().getProgramChangeNumber());
+        }
 
-    midiManager->processMidiBuffer(midiMessages);
+        midiManager->processMidiBuffer(midiMessages);
     
-    // 1.5 Chord Memory (Expand Notes)
-    chordMemory.process(midiMessages);
+        // 1.5 Chord Memory (Expand Notes)
+        chordMemory.process(midiMessages);
     
-    keyboardState.processNextMidiBuffer (midiMessages, 0, buffer.getNumSamples(), true);
+        keyboardState.processNextMidiBuffer (midiMessages, 0, buffer.getNumSamples(), true);
+    }
 
     // --- Audio Input Handling (Multi-FX Mode) ---
-    auto* extGain = apvts.getRawParameterValue("ext_audio_gain");
-    float inputGain = extGain ? extGain->load() : 0.0f;
+    float inputGain = live.extAudioGain ? live.extAudioGain->load() : 0.0f;
     
     if (inputGain > 0.001f)
     {
@@ -132,130 +207,392 @@ void DeepMindSynthAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
         buffer.clear();
     }
 
-    // Handle MIDI CCs matching DeepMind Spec
-    for (const auto metadata : midiMessages)
-    {
-        auto message = metadata.getMessage();
-        if (message.isController())
-        {
-            int ccNumber = message.getControllerNumber();
-            float value = message.getControllerValue() / 127.0f; // Normalize 0-1
-            
-            // Map CC to Parameter ID (Hardcoded mapping from CSV)
-            juce::String paramId = "";
-            
-            switch (ccNumber)
-            {
-                case 29: paramId = "vcf_freq"; break; // VCF Freq
-                case 30: paramId = "vcf_res"; break;  // VCF Reso
-                case 16: paramId = "lfo1_rate"; break; // LFO1 Rate
-                case 21: paramId = "dco1_pwm"; break;  // OSC1 PWM
-                case 28: paramId = "unison_detune"; break; // Unison
-                case 10: paramId = "pan"; break; // Pan
-                case 37: paramId = "arp_rate"; break; // Arp Rate
-                // ... Add more mappings as needed
-            }
-            
-            if (paramId.isNotEmpty())
-            {
-                auto* param = apvts.getParameter(paramId);
-                if (param) param->setValueNotifyingHost(value); 
-            }
-        }
-    }
+    // Parameter changes for this block (mapped CCs + OSC), sorted by sample offset.
+    // Collected before the Arp, which consumes the incoming MIDI.
+    collectParameterEvents(midiMessages, oscReceiver->popBlockEvents(buffer.getNumSamples()));
     
     // Update Arpeggiator Parameters
-    auto* arpOn = apvts.getRawParameterValue("arp_on");
-    auto* arpMode = apvts.getRawParameterValue("arp_mode");
-    auto* arpRate = apvts.getRawParameterValue("arp_rate");
-    auto* arpOct = apvts.getRawParameterValue("arp_oct");
-    
-    if (arpOn) arpeggiator.setBypass(*arpOn < 0.5f);
-    if (arpMode) arpeggiator.setMode(static_cast<DeepMindDSP::ArpMode>((int)*arpMode));
-    if (arpRate) arpeggiator.setRate(4.0f + (*arpRate * 20.0f)); // Simple mapping 4Hz to 24Hz for verification
-    if (arpOct) arpeggiator.setOctaveRange((int)*arpOct);
-    
-    auto* arpPat = apvts.getRawParameterValue("arp_pattern");
-    if (arpPat) arpeggiator.setPattern((int)*arpPat);
+    if (live.arpOn) arpeggiator.setBypass(*live.arpOn < 0.5f);
+    if (live.arpMode) arpeggiator.setMode(static_cast<DeepMindDSP::ArpMode>((int)*live.arpMode));
+    if (live.arpRate) arpeggiator.setRate(4.0f + (*live.arpRate * 20.0f)); // Simple mapping 4Hz to 24Hz for verification
+    if (live.arpOct) arpeggiator.setOctaveRange((int)*live.arpOct);
+    if (live.arpPattern) arpeggiator.setPattern((int)*live.arpPattern);
 
     // Process Arpeggiator (Generates new MIDI notes based on held chords)
     // It modifies 'midiMessages' in place (clears input, adds arp notes)
-    // It modifies 'midiMessages' in place (clears input, adds arp notes)
-    arpeggiator.processBlock(midiMessages, buffer.getNumSamples());
+    {
+        DEEPMIND_TRACE_ZONE("arp");
+        arpeggiator.processBlock(midiMessages, buffer.getNumSamples());
+    }
+
+    // --- Engine Idle ---
+    // Nothing can sound this block: no voices left, no external input, FX tails
+    // decayed and no MIDI for the synth. MIDI, Arp and OSC above still run every block.
+    bool idle = activeVoiceCount.load() == 0
+             && inputGain <= 0.001f
+             && midiMessages.isEmpty()
+             && fxSilentSamples >= fxTailHoldSamples;
+    engineIdle.store(idle);
+    
+    if (idle)
+    {
+        // Nothing to time them against; the voices pick them up on the next render
+        for (const auto& event : parameterEvents)
+        {
+            stateSerializer.setLiveValue(event.parameterIndex, event.value);
+            dirtyVoiceGroups.fetch_or(parameterVoiceGroups[(size_t)event.parameterIndex]);
+        }
+        
+        buffer.clear();
+        presetLoader->endBlock(buffer); // Keep the preset hand-over moving while silent
+        midiManager->processOutgoingMidi(midiMessages);
+        return;
+    }
 
     // Update FX
-    auto* chorusMix = apvts.getRawParameterValue("fx_chorus_mix");
-    auto* chorusRate = apvts.getRawParameterValue("fx_chorus_rate");
-    auto* chorusDepth = apvts.getRawParameterValue("fx_chorus_depth");
-    
-    auto* delayMix = apvts.getRawParameterValue("fx_delay_mix");
-    auto* delayTime = apvts.getRawParameterValue("fx_delay_time");
-    auto* delayFb = apvts.getRawParameterValue("fx_delay_feedback");
-
-    auto* reverbMix = apvts.getRawParameterValue("fx_reverb_mix");
-    auto* reverbSize = apvts.getRawParameterValue("fx_reverb_size");
-    auto* reverbDamp = apvts.getRawParameterValue("fx_reverb_damp");
-    
-    if (chorusMix) fxChain.setChorusParams(
-        chorusRate ? chorusRate->load() : 1.0f,
-        chorusDepth ? chorusDepth->load() : 0.5f,
-        chorusMix->load()
+    if (live.chorusMix) fxChain.setChorusParams(
+        live.chorusRate ? live.chorusRate->load() : 1.0f,
+        live.chorusDepth ? live.chorusDepth->load() : 0.5f,
+        live.chorusMix->load()
     );
 
-    if (delayMix) fxChain.setDelayParams(
-        delayTime ? delayTime->load() : 0.5f,
-        delayFb ? delayFb->load() : 0.0f,
-        delayMix->load()
+    if (live.delayMix) fxChain.setDelayParams(
+        live.delayTime ? live.delayTime->load() : 0.5f,
+        live.delayFeedback ? live.delayFeedback->load() : 0.0f,
+        live.delayMix->load()
     );
      
-    if (reverbMix) fxChain.setReverbParams(
-        reverbSize ? reverbSize->load() : 0.5f,
-        reverbDamp ? reverbDamp->load() : 0.5f,
-        reverbMix->load()
+    if (live.reverbMix) fxChain.setReverbParams(
+        live.reverbSize ? live.reverbSize->load() : 0.5f,
+        live.reverbDamp ? live.reverbDamp->load() : 0.5f,
+        live.reverbMix->load()
     );
 
-    // Update Voice Parameters
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    // Synth + FX, at the engine rate (resampled when that isn't the host rate)
+    if (resampler.getFactor() > 1)
+        renderEngineResampled(buffer, midiMessages);
+    else
+        renderEngine(buffer, midiMessages);
+    
+    // Track FX tail decay for the idle check
+    float outPeak = buffer.getMagnitude(0, buffer.getNumSamples());
+    if (outPeak < idleThresholdGain)
+        fxSilentSamples = juce::jmin(fxSilentSamples + buffer.getNumSamples(), fxTailHoldSamples);
+    else
+        fxSilentSamples = 0;
+    
+    // Preset swap fade (out before the swap, in after)
+    presetLoader->endBlock(buffer);
+    
+    // Send Outgoing MIDI (CC/NRPN from UI)
+    midiManager->processOutgoingMidi(midiMessages);
+}
+
+void DeepMindSynthAudioProcessor::collectParameterEvents(const juce::MidiBuffer& midi, int numOscEvents)
+{
+    parameterEvents.clear();
+    
+    // Handle MIDI CCs matching DeepMind Spec (at the CC's own sample position)
+    for (const auto metadata : midi)
     {
-        if (auto* voice = dynamic_cast<voice::SynthVoice*>(synthesiser.getVoice(i)))
+        auto message = metadata.getMessage();
+        if (!message.isController()) continue;
+        
+        int index = ccToParameter[(size_t)message.getControllerNumber()];
+        if (index >= 0 && (int)parameterEvents.size() < maxParameterEventsPerBlock)
+            parameterEvents.push_back({ metadata.samplePosition, index, message.getControllerValue() / 127.0f });
+    }
+    
+    // OSC, merged in by offset. Insertion keeps arrival order for equal offsets. Applied
+    // like the CCs (live value only), never through setValueNotifyingHost here.
+    const auto* oscEvents = oscReceiver->getBlockEvents();
+    for (int i = 0; i < numOscEvents && (int)parameterEvents.size() < maxParameterEventsPerBlock; ++i)
+    {
+        ParameterEvent event { oscEvents[i].sampleOffset, oscEvents[i].parameterIndex, oscEvents[i].value };
+        parameterEvents.push_back(event);
+        
+        for (size_t j = parameterEvents.size() - 1; j > 0 && parameterEvents[j - 1].sampleOffset > event.sampleOffset; --j)
+            std::swap(parameterEvents[j], parameterEvents[j - 1]);
+    }
+}
+
+void DeepMindSynthAudioProcessor::renderSynth(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+{
+    const int numSamples = buffer.getNumSamples();
+    const int numEvents = (int)parameterEvents.size();
+    
+    int segmentStart = 0;
+    int nextEvent = 0;
+    juce::uint32 changedGroups = dirtyVoiceGroups.exchange(0); // Host automation / UI since the last render
+    
+    while (segmentStart < numSamples)
+    {
+        // Apply everything due here. Events inside the minimum sub-block are pulled
+        // forward a few samples rather than creating a tiny segment.
+        while (nextEvent < numEvents && parameterEvents[(size_t)nextEvent].sampleOffset < segmentStart + minimumSubBlockSamples)
         {
-            voice->updateParameters(&apvts);
+            const auto& event = parameterEvents[(size_t)nextEvent++];
+            stateSerializer.setLiveValue(event.parameterIndex, event.value);
+            changedGroups |= parameterVoiceGroups[(size_t)event.parameterIndex];
         }
+        
+        int segmentEnd = juce::jmin(numSamples, segmentStart + controlBlockSamples);
+        if (nextEvent < numEvents)
+            segmentEnd = juce::jmin(segmentEnd, parameterEvents[(size_t)nextEvent].sampleOffset);
+        
+        if (changedGroups != 0)
+        {
+            updateVoiceParameters(changedGroups);
+            changedGroups = 0;
+        }
+        
+        // The Synthesiser further splits at note/pitch/CC MIDI inside the segment
+        synthesiser.renderNextBlock(buffer, midi, segmentStart, segmentEnd - segmentStart);
+        segmentStart = segmentEnd;
+    }
+    
+    // Events at or past the end (e.g. an empty engine block): voices pick them up next block
+    for (; nextEvent < numEvents; ++nextEvent)
+    {
+        const auto& event = parameterEvents[(size_t)nextEvent];
+        stateSerializer.setLiveValue(event.parameterIndex, event.value);
+        dirtyVoiceGroups.fetch_or(parameterVoiceGroups[(size_t)event.parameterIndex]);
     }
+}
 
-    synthesiser.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
+void DeepMindSynthAudioProcessor::renderEngine(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+{
+    // Synth (split at parameter events, see renderSynth)
+    {
+        DEEPMIND_TRACE_ZONE("synth");
+        renderSynth(buffer, midi);
+    }
+    
+    // Publish Voice Activity (voices end themselves once their tail is inaudible)
+    int numActive = 0;
+    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+        if (synthesiser.getVoice(i)->isVoiceActive()) ++numActive;
+    activeVoiceCount.store(numActive);
     
     // Ensure we don't silence the synth if input gain is 0 (which is handled above).
     // Synth renders ADDITIVELY to buffer.
     
+    DEEPMIND_TRACE_ZONE("fx");
     juce::dsp::AudioBlock<float> block(buffer);
     fxChain.process(block);
+}
+
+void DeepMindSynthAudioProcessor::renderEngineResampled(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+{
+    const int engineSamples = resampler.beginBlock(buffer.getNumSamples());
     
-    // Send Outgoing MIDI (CC/NRPN from UI)
-    midiManager->processOutgoingMidi(midiMessages);
+    // External input (or silence) down to the engine rate
+    {
+        DEEPMIND_TRACE_ZONE("resample: down");
+        resampler.downsample(buffer, engineBuffer);
+    }
+    
+    // Re-time MIDI and parameter events to engine samples (order is preserved)
+    engineMidi.clear();
+    for (const auto metadata : midi)
+        engineMidi.addEvent(metadata.getMessage(), resampler.toInternalOffset(metadata.samplePosition));
+    
+    for (auto& event : parameterEvents)
+        event.sampleOffset = resampler.toInternalOffset(event.sampleOffset);
+    
+    // View of this block's engine samples (no allocation)
+    juce::AudioBuffer<float> engineBlock(engineBuffer.getArrayOfWritePointers(), engineBuffer.getNumChannels(), engineSamples);
+    renderEngine(engineBlock, engineMidi);
+    
+    DEEPMIND_TRACE_ZONE("resample: up");
+    resampler.upsample(engineBlock, buffer);
+}
+
+int DeepMindSynthAudioProcessor::engineFactorFor(double hostRate, EngineRate rate)
+{
+    if (rate == EngineRate::Host) return 1;
+    
+    const double minimumRate = rate == EngineRate::High ? 88200.0 : 44100.0;
+    for (int factor : { 4, 2 })
+        if (hostRate / factor >= minimumRate - 1.0)
+            return factor;
+    
+    return 1;
+}
+
+void DeepMindSynthAudioProcessor::setEngineRate(EngineRate newRate)
+{
+    // Through the parameter, so the choice is saved with the state
+    if (auto* param = apvts.getParameter("engine_rate"))
+        param->setValueNotifyingHost(param->convertTo0to1((float)newRate));
+}
+
+void DeepMindSynthAudioProcessor::applyEngineRate(EngineRate newRate)
+{
+    if (engineRate.exchange(newRate) == newRate) return;
+    
+    // Re-prepare with the new rate (and latency) if we're already running
+    if (getSampleRate() > 0.0 && getBlockSize() > 0)
+    {
+        suspendProcessing(true);
+        prepareToPlay(getSampleRate(), getBlockSize());
+        suspendProcessing(false);
+    }
+}
+
+void DeepMindSynthAudioProcessor::prefaultBuffers()
+{
+    // Reserved but never written yet
+    parameterEvents.resize(parameterEvents.capacity());
+    parameterEvents.clear();
+    
+    // ~100 ms of every voice playing, at the engine rate
+    const int blockSize = engineBuffer.getNumSamples();
+    const int numBlocks = juce::jmax(1, (int)(0.1 * engineSampleRate) / juce::jmax(1, blockSize));
+    
+    juce::MidiBuffer chord;
+    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+        chord.addEvent(juce::MidiMessage::noteOn(1, 48 + i * 3, 0.8f), 0);
+    
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        engineBuffer.clear();
+        juce::MidiBuffer midi;
+        if (block == 0) midi = chord;
+        renderEngine(engineBuffer, midi);
+    }
+    
+    // The render above only reaches the first 100 ms of the FX lines
+    synthesiser.allNotesOff(0, false);
+    fxChain.prefault(fxTailHoldSeconds);
+    resampler.reset();
+    engineBuffer.clear();
+    activeVoiceCount.store(0);
+    fxSilentSamples = 0;
+}
+
+void DeepMindSynthAudioProcessor::applyQualityTier()
+{
+    const int tierIndex = governor.getTierIndex();
+    if (tierIndex == appliedQualityTier) return;
+    appliedQualityTier = tierIndex;
+    
+    const auto& tier = DeepMindDSP::QualityGovernor::getTier(tierIndex);
+    controlBlockSamples = tier.controlBlockSamples;
+    
+    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+        if (auto* voice = dynamic_cast<voice::SynthVoice*>(synthesiser.getVoice(i)))
+            voice->setQualityLimits(tier.maxUnisonLayers, tier.stereoUnison);
+    
+    oscFeedback->setQualityTier(tierIndex); // Lock-free, sent with the next feedback bundle
+}
+
+void DeepMindSynthAudioProcessor::setOscFeedbackTarget(const juce::String& host, int port)
+{
+    if (oscFeedback->connect(host, port))
+        oscFeedback->markAllDirty(); // The new controller starts from the full state
+}
+
+void DeepMindSynthAudioProcessor::handleOscControl(const juce::OSCMessage& message)
+{
+    const auto address = message.getAddressPattern().toString();
+    
+    // /deepmind/feedback <host> [port]: a controller on another device asks for feedback
+    // at its own address (OSC receivers don't see the sender's address)
+    if (address == "/deepmind/feedback" && message.size() >= 1 && message[0].isString())
+    {
+        const int port = message.size() >= 2 && message[1].isInt32() ? message[1].getInt32() : defaultOscFeedbackPort;
+        setOscFeedbackTarget(message[0].getString(), port);
+    }
+    
+#if DEEPMIND_TRACING
+    // /deepmind/trace <file.json> starts a capture, /deepmind/trace with no file writes
+    // it out. The plugin's own trigger (the headless build also has SIGUSR1). Relative
+    // names land in the user's documents folder.
+    if (address == "/deepmind/trace")
+    {
+        auto& recorder = DeepMindDSP::TraceRecorder::getInstance(); // First call allocates the rings: not the audio thread
+        if (message.size() >= 1 && message[0].isString())
+        {
+            auto file = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile(message[0].getString());
+            recorder.start(file); // Ignored while a capture is running
+        }
+        else
+        {
+            recorder.stop();
+        }
+    }
+#endif
+}
+
+voice::SynthVoice* DeepMindSynthAudioProcessor::createVoice()
+{
+    auto* voice = new voice::SynthVoice();
+    voice->attachParameters(stateSerializer); // Parameter lookups by ID happen here, once
+    return voice;
+}
+
+void DeepMindSynthAudioProcessor::updateVoiceParameters(juce::uint32 groups)
+{
+    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+    {
+        if (auto* voice = dynamic_cast<voice::SynthVoice*>(synthesiser.getVoice(i)))
+        {
+            voice->updateParameters(groups);
+        }
+    }
 }
 
 bool DeepMindSynthAudioProcessor::hasEditor() const
 {
+#if DEEPMIND_HEADLESS
+    return false; // Headless build: OSC / MIDI control only, the editor isn't compiled in
+#else
     return true;
+#endif
 }
 
 juce::AudioProcessorEditor* DeepMindSynthAudioProcessor::createEditor()
 {
+#if DEEPMIND_HEADLESS
+    return nullptr;
+#else
     return new DeepMindSynthAudioProcessorEditor (*this);
+#endif
 }
 
 void DeepMindSynthAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // Store parameters as XML
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml (state.createXml());
-    copyXmlToBinary (*xml, destData);
+    // Store parameters as compact binary (see StateSerializer for the layout), plus
+    // whatever else lives in the APVTS state, which the XML dump used to carry along
+    juce::ValueTree extras(apvts.state.getType());
+    extras.copyPropertiesFrom(apvts.state, nullptr);
+    for (const auto& child : apvts.state)
+        if (!child.hasType("PARAM"))
+            extras.appendChild(child.createCopy(), nullptr);
+    
+    stateSerializer.write(destData, extras);
 }
 
 void DeepMindSynthAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // Restore parameters from XML
+    // Binary state (current format, migrated if older)
+    juce::ValueTree extras;
+    if (stateSerializer.read(data, sizeInBytes, &extras))
+    {
+        if (extras.isValid())
+        {
+            apvts.state.copyPropertiesFrom(extras, nullptr);
+            for (int i = apvts.state.getNumChildren(); --i >= 0;)
+                if (!apvts.state.getChild(i).hasType("PARAM"))
+                    apvts.state.removeChild(i, nullptr);
+            for (const auto& child : extras)
+                apvts.state.appendChild(child.createCopy(), nullptr);
+        }
+        return;
+    }
+    
+    // Legacy: restore parameters from XML (projects saved before the binary format)
     std::unique_ptr<juce::XmlElement> xmlState (getXmlFromBinary (data, sizeInBytes));
     if (xmlState.get() != nullptr)
         if (xmlState->hasTagName (apvts.state.getType()))
@@ -268,18 +605,44 @@ bool DeepMindSynthAudioProcessor::acceptsMidi() const { return true; }
 bool DeepMindSynthAudioProcessor::producesMidi() const { return true; }
 bool DeepMindSynthAudioProcessor::isMidiEffect() const { return false; }
 double DeepMindSynthAudioProcessor::getTailLengthSeconds() const { return 0.0; }
-int DeepMindSynthAudioProcessor::getNumPrograms() { return 1; }
-int DeepMindSynthAudioProcessor::getCurrentProgram() { return 0; }
-void DeepMindSynthAudioProcessor::setCurrentProgram (int index) {}
-const juce::String DeepMindSynthAudioProcessor::getProgramName (int index) { return {}; }
+// Programs are the presets directory in name order (see PresetLoader)
+int DeepMindSynthAudioProcessor::getNumPrograms() { return presetLoader->getNumPrograms(); }
+int DeepMindSynthAudioProcessor::getCurrentProgram() { return presetLoader->getCurrentProgram(); }
+void DeepMindSynthAudioProcessor::setCurrentProgram (int index) { presetLoader->requestProgram(index); }
+const juce::String DeepMindSynthAudioProcessor::getProgramName (int index) { return presetLoader->getProgramName(index); }
 void DeepMindSynthAudioProcessor::changeProgramName (int index, const juce::String& newName) {}
 
+void DeepMindSynthAudioProcessor::setVoiceSilenceThreshold(float thresholdDb, double holdSeconds)
+{
+    voiceSilenceThresholdDb.store(thresholdDb);
+    voiceSilenceHoldSeconds.store(juce::jmax(0.0, holdSeconds));
+    voiceSilenceChanged.store(true);
+}
+
+void DeepMindSynthAudioProcessor::applyVoiceSilenceThreshold()
+{
+    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
+        if (auto* voice = dynamic_cast<voice::SynthVoice*>(synthesiser.getVoice(i)))
+            voice->setSilenceThreshold(voiceSilenceThresholdDb.load(), voiceSilenceHoldSeconds.load());
+}
+
 // --- Listener ---
 void DeepMindSynthAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
 {
+    // Changes made on the audio thread (CCs, OSC, presets) arrive here on the message
+    // thread (see StateSerializer::setLiveValue); only host automation can come from elsewhere
+    const bool onMessageThread = juce::MessageManager::existsAndIsCurrentThread();
+    
     if (parameterID == "polyphony_mode")
     {
-        juce::MessageManager::callAsync([this]() { updatePolyphony(); });
+        if (onMessageThread) updatePolyphony();
+        else juce::MessageManager::callAsync([this]() { updatePolyphony(); });
+    }
+    else if (parameterID == "engine_rate")
+    {
+        auto rate = static_cast<EngineRate>(juce::jlimit(0, 2, (int)newValue));
+        if (onMessageThread) applyEngineRate(rate);
+        else juce::MessageManager::callAsync([this, rate]() { applyEngineRate(rate); });
     }
 }
 
@@ -310,10 +673,14 @@ void DeepMindSynthAudioProcessor::updatePolyphony()
     suspendProcessing(true);
     synthesiser.clearVoices();
     for(int i=0; i<target; ++i)
-        synthesiser.addVoice(new voice::SynthVoice());
+        synthesiser.addVoice(createVoice());
+    synthesiser.applyPitchBendRanges();
+    appliedQualityTier = -1; // New voices get the current tier's limits on the next block
+    voiceSilenceChanged.store(true); // ...and the silence threshold
         
+    // Voices run at the engine rate, which is below the host rate when resampling
     if (getSampleRate() > 0)
-        synthesiser.setCurrentPlaybackSampleRate(getSampleRate());
+        synthesiser.setCurrentPlaybackSampleRate(engineSampleRate);
         
     suspendProcessing(false);
 }
@@ -1,12 +1,20 @@
 #pragma once
 #include <JuceHeader.h>
+#include <array>
 #include <atomic>
+#include <vector>
 #include "Voice/SynthVoice.h"
+#include "Voice/DeepMindSynthesiser.h"
 #include "DSP/Effects/FxChain.h"
 #include "DSP/Arpeggiator/Arpeggiator.h"
 #include "Data/MidiManager.h"
-#include "Data/OscManager.h"
 #include "Data/ChordMemory.h"
+#include "Data/StateSerializer.h"
+#include "Data/PresetLoader.h"
+#include "Data/OscParameterReceiver.h"
+#include "Data/OscFeedbackSender.h"
+#include "DSP/PolyphaseResampler.h"
+#include "DSP/QualityGovernor.h"
 
 class DeepMindSynthAudioProcessor  : public juce::AudioProcessor, public juce::AudioProcessorValueTreeState::Listener
 {
@@ -30,6 +38,7 @@ public:
     bool producesMidi() const override;
     bool isMidiEffect() const override;
     double getTailLengthSeconds() const override;
+    bool supportsMPE() const override { return true; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override;
@@ -44,24 +53,134 @@ public:
     void parameterChanged(const juce::String& parameterID, float newValue) override;
     void updatePolyphony();
     
+    // Internal engine rate: synth + FX can run below a high host rate (e.g. 48 kHz
+    // inside a 96 kHz session) and get resampled, at the cost of a little latency
+    // (reported to the host). Host = no resampling.
+    // Standard runs the engine at >= 44.1 kHz, High at >= 88.2 kHz (only integer factors).
+    // Stored in the non-automatable "engine_rate" choice parameter.
+    enum class EngineRate { Host, Standard, High };
+    void setEngineRate(EngineRate newRate);
+    EngineRate getEngineRate() const { return engineRate.load(); }
+    double getEngineSampleRate() const { return engineSampleRate; }
+    
+    // Plays a short chord through the engine into a scratch buffer, then runs the FX
+    // chain over the full length of its delay and reverb lines, so every buffer and
+    // lazily built table is touched before the first real note (no page faults on the
+    // audio thread). Call after prepareToPlay with
+    // audio stopped; the engine is left reset and silent.
+    void prefaultBuffers();
+    
+    // MPE lower zone (also switched on/off by MPE Configuration Messages)
+    void setMpeEnabled(bool shouldBeEnabled) { synthesiser.setMpeEnabled(shouldBeEnabled); }
+    bool isMpeEnabled() const { return synthesiser.isMpeEnabled(); }
+    
     // Public for Editor access
     data::ChordMemory chordMemory;
-    std::unique_ptr<data::OscManager> oscManager;
-    float getCpuUsage() const { return 0.0f; } // Placeholder
+    float getCpuUsage() const { return governor.getLoad() * 100.0f; } // % of the block's real-time budget
+    
+    // Quality governor: steps quality down under CPU pressure instead of dropping out
+    int getQualityTier() const { return governor.getTierIndex(); }
+    const char* getQualityTierName() const { return DeepMindDSP::QualityGovernor::getTier(governor.getTierIndex()).name; }
+    void setQualityGovernorEnabled(bool shouldBeEnabled) { governor.setEnabled(shouldBeEnabled); }
     std::atomic<int> lastNoteTriggered { -1 };
+    int getActiveVoiceCount() const { return activeVoiceCount.load(); }
+    
+    // Releasing voices that stay below thresholdDb for holdSeconds are ended early
+    // (default -96 dBFS, 50 ms). Any thread; reaches the voices on the next block.
+    void setVoiceSilenceThreshold(float thresholdDb, double holdSeconds);
+    
+    // OSC feedback goes to 127.0.0.1:9000 until a controller asks for it elsewhere with
+    // /deepmind/feedback <host> [port] (sent to port 8000), or this is called. Any
+    // non-audio thread; the new target gets the full parameter state.
+    void setOscFeedbackTarget(const juce::String& host, int port);
+    static constexpr int defaultOscFeedbackPort = 9000;
+    bool isEngineIdle() const { return engineIdle.load(); }
 
     juce::AudioProcessorValueTreeState apvts;
     juce::MidiKeyboardState keyboardState;
     std::unique_ptr<data::MidiManager> midiManager;
+    std::unique_ptr<data::PresetLoader> presetLoader;
+    std::unique_ptr<data::OscFeedbackSender> oscFeedback; // Port 9000 TX, coalesced bundles
 
 private:
-    juce::Synthesiser synthesiser;
+    voice::DeepMindSynthesiser synthesiser;
     DeepMindDSP::FxChain fxChain;
     DeepMindDSP::Arpeggiator arpeggiator; 
+    data::StateSerializer stateSerializer { *this }; // After apvts: snapshots the parameter layout
+    std::unique_ptr<data::OscParameterReceiver> oscReceiver; // Port 8000, applied sample-accurately
+    void handleOscControl(const juce::OSCMessage& message); // Network thread
+    std::atomic<int> activeVoiceCount { 0 }; // Published after each render
+    
+    // Engine Idle (silence short-circuit)
+    std::atomic<bool> engineIdle { false };
+    int fxSilentSamples = 0;      // Consecutive samples of silent FX output
+    int fxTailHoldSamples = 0;    // Silence needed before FX tails count as decayed
+    static constexpr float idleThresholdGain = 1.5849e-5f; // -96 dBFS
+    static constexpr double fxTailHoldSeconds = 3.0;       // Longer than the longest delay gap
+    
+    // Voice silence detection
+    void applyVoiceSilenceThreshold(); // Audio thread
+    std::atomic<float> voiceSilenceThresholdDb { -96.0f };
+    std::atomic<double> voiceSilenceHoldSeconds { 0.05 };
+    std::atomic<bool> voiceSilenceChanged { true }; // Also set when voices are rebuilt
     // data::ChordMemory chordMemory; // Moved to public
     // std::unique_ptr<data::MidiManager> midiManager; // Moved to public
     
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+    voice::SynthVoice* createVoice(); // Message thread: new voice with its parameters attached
+    void updateVoiceParameters(juce::uint32 groups); // voice::SynthVoice::ParameterGroup bits
+    
+    // --- Sample-accurate rendering ---
+    // Parameter changes (mapped CCs, OSC) are collected with their sample offsets and the
+    // synth is rendered in segments between them. They go to the live values only; the
+    // host and the listeners are told from the message thread (StateSerializer). Segments are also capped at
+    // controlBlockSamples so voice modulation runs at a fixed rate whatever the host
+    // buffer size. Events closer than minimumSubBlockSamples are merged into one split.
+    struct ParameterEvent
+    {
+        int sampleOffset;
+        int parameterIndex; // StateSerializer layout
+        float value;        // Normalised
+    };
+    
+    void collectParameterEvents(const juce::MidiBuffer& midi, int numOscEvents);
+    void renderSynth(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi);
+    void renderEngine(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi); // Synth + FX
+    void renderEngineResampled(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi);
+    
+    std::vector<ParameterEvent> parameterEvents; // Reserved in prepareToPlay
+    std::array<int, 128> ccToParameter;          // CC number -> layout index (-1 = unmapped)
+    std::vector<juce::uint32> parameterVoiceGroups; // Layout index -> SynthVoice parameter group
+    std::atomic<juce::uint32> dirtyVoiceGroups { voice::SynthVoice::allGroups }; // Changed by host / UI since the last render
+    int controlBlockSamples = 64; // Set by the quality tier
+    static constexpr int minimumSubBlockSamples = 16;
+    static constexpr int maxParameterEventsPerBlock = 4096;
+    
+    // Live values the processor reads each block (StateSerializer), resolved once;
+    // nullptr = parameter not in the layout
+    using Param = std::atomic<float>*;
+    struct LiveParameters
+    {
+        Param extAudioGain = nullptr;
+        Param arpOn = nullptr, arpMode = nullptr, arpRate = nullptr, arpOct = nullptr, arpPattern = nullptr;
+        Param chorusMix = nullptr, chorusRate = nullptr, chorusDepth = nullptr;
+        Param delayMix = nullptr, delayTime = nullptr, delayFeedback = nullptr;
+        Param reverbMix = nullptr, reverbSize = nullptr, reverbDamp = nullptr;
+    } live;
+    
+    // --- Quality governor ---
+    void applyQualityTier();
+    DeepMindDSP::QualityGovernor governor;
+    int appliedQualityTier = -1;
+    
+    // --- Internal engine rate ---
+    static int engineFactorFor(double hostRate, EngineRate rate);
+    void applyEngineRate(EngineRate newRate); // Message thread, from the parameter
+    std::atomic<EngineRate> engineRate { EngineRate::Host };
+    double engineSampleRate = 44100.0;
+    DeepMindDSP::PolyphaseResampler resampler;
+    juce::AudioBuffer<float> engineBuffer;  // Internal-rate block (synth + FX)
+    juce::MidiBuffer engineMidi;            // MIDI re-timed to engine samples
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DeepMindSynthAudioProcessor)
 };
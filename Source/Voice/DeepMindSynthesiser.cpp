@@ -0,0 +1,149 @@
+#include "DeepMindSynthesiser.h"
+#include "SynthVoice.h"
+
+using namespace voice;
+
+void DeepMindSynthesiser::setMpeEnabled(bool shouldBeEnabled)
+{
+    const juce::ScopedLock sl(lock);
+    
+    if (shouldBeEnabled)
+        zoneLayout.setLowerZone(15);
+    else
+        zoneLayout.clearAllZones();
+    
+    updateFromZoneLayout();
+}
+
+void DeepMindSynthesiser::updateFromZoneLayout()
+{
+    auto lower = zoneLayout.getLowerZone();
+    auto upper = zoneLayout.getUpperZone();
+    
+    lowerMaster = lower.isActive() ? lower.getMasterChannel() : 0;
+    upperMaster = upper.isActive() ? upper.getMasterChannel() : 0;
+    mpeEnabled = lowerMaster != 0 || upperMaster != 0;
+    
+    if (mpeEnabled)
+    {
+        const auto& zone = lower.isActive() ? lower : upper;
+        noteBendRange = (float)zone.perNotePitchbendRange;
+        masterBendRange = (float)zone.masterPitchbendRange;
+    }
+    else
+    {
+        noteBendRange = 2.0f;
+        masterBendRange = 2.0f;
+    }
+    
+    applyPitchBendRanges();
+}
+
+void DeepMindSynthesiser::applyPitchBendRanges()
+{
+    for (auto* v : voices)
+        if (auto* synthVoice = dynamic_cast<SynthVoice*>(v))
+            synthVoice->setPitchBendRanges(noteBendRange, masterBendRange);
+}
+
+bool DeepMindSynthesiser::isMasterChannel(int midiChannel) const
+{
+    return mpeEnabled && (midiChannel == lowerMaster || midiChannel == upperMaster);
+}
+
+void DeepMindSynthesiser::handleMidiEvent(const juce::MidiMessage& message)
+{
+    // MPE Configuration Messages are RPN 6 on a master channel
+    if (message.isController())
+    {
+        auto lower = zoneLayout.getLowerZone();
+        auto upper = zoneLayout.getUpperZone();
+        
+        zoneLayout.processNextMidiEvent(message);
+        
+        if (lower != zoneLayout.getLowerZone() || upper != zoneLayout.getUpperZone())
+            updateFromZoneLayout();
+    }
+    
+    juce::Synthesiser::handleMidiEvent(message);
+}
+
+void DeepMindSynthesiser::noteOn(int midiChannel, int midiNoteNumber, float velocity)
+{
+    // Whichever voice the base class picks starts from these in startNote
+    if (juce::isPositiveAndBelow(midiChannel, (int)channelExpression.size()))
+    {
+        const auto& held = channelExpression[(size_t)midiChannel];
+        for (auto* v : voices)
+            if (auto* synthVoice = dynamic_cast<SynthVoice*>(v))
+                synthVoice->setHeldExpression(held.modWheel, held.timbre, held.pressure);
+    }
+    
+    juce::Synthesiser::noteOn(midiChannel, midiNoteNumber, velocity);
+}
+
+void DeepMindSynthesiser::handlePitchWheel(int midiChannel, int wheelValue)
+{
+    if (isMasterChannel(midiChannel))
+    {
+        // Whole-zone bend, on top of each note's own bend
+        for (auto* v : voices)
+            if (auto* synthVoice = dynamic_cast<SynthVoice*>(v))
+                synthVoice->masterPitchWheelMoved(wheelValue);
+        return;
+    }
+    
+    juce::Synthesiser::handlePitchWheel(midiChannel, wheelValue);
+}
+
+void DeepMindSynthesiser::handleController(int midiChannel, int controllerNumber, int controllerValue)
+{
+    if (isMasterChannel(midiChannel))
+    {
+        // Every voice sits on exactly one channel, so this reaches each voice once
+        // (and applies pedals to all member channels)
+        // (and applies pedals to all member channels). Stored per channel as well, so
+        // a later note on a member channel starts from the master's mod wheel until that
+        // channel sends its own.
+        for (int channel = 1; channel <= 16; ++channel)
+        {
+            storeController(channel, controllerNumber, controllerValue);
+            juce::Synthesiser::handleController(channel, controllerNumber, controllerValue);
+        }
+        return;
+    }
+    
+    storeController(midiChannel, controllerNumber, controllerValue);
+    juce::Synthesiser::handleController(midiChannel, controllerNumber, controllerValue);
+}
+
+void DeepMindSynthesiser::storeController(int midiChannel, int controllerNumber, int controllerValue)
+{
+    if (!juce::isPositiveAndBelow(midiChannel, (int)channelExpression.size())) return;
+    
+    auto& held = channelExpression[(size_t)midiChannel];
+    switch (controllerNumber)
+    {
+        case 1:   held.modWheel = controllerValue / 127.0f; break;
+        case 74:  held.timbre = controllerValue / 127.0f; break;
+        case 121: held = {}; break; // Reset All Controllers
+        default:  break;
+    }
+}
+
+void DeepMindSynthesiser::handleChannelPressure(int midiChannel, int channelPressureValue)
+{
+    if (isMasterChannel(midiChannel))
+    {
+        for (int channel = 1; channel <= 16; ++channel)
+        {
+            channelExpression[(size_t)channel].pressure = channelPressureValue / 127.0f;
+            juce::Synthesiser::handleChannelPressure(channel, channelPressureValue);
+        }
+        return;
+    }
+    
+    if (juce::isPositiveAndBelow(midiChannel, (int)channelExpression.size()))
+        channelExpression[(size_t)midiChannel].pressure = channelPressureValue / 127.0f;
+    juce::Synthesiser::handleChannelPressure(midiChannel, channelPressureValue);
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+namespace voice
+{
+    // juce::Synthesiser with MPE routing.
+    // Per-note expression needs nothing special: in an MPE zone every note has its own
+    // channel, and the base class already sends pitch bend, channel pressure and CCs
+    // only to voices playing that channel. This class adds the zone's master channel:
+    // its controllers and pedals reach every voice, and its pitch bend is kept apart
+    // from the per-note bend (different ranges).
+    // Zones come from MPE Configuration Messages in the MIDI stream or from setMpeEnabled().
+    // The last mod wheel, CC 74 and channel pressure of each channel are kept so a new
+    // note starts from where its channel is, not from zero.
+    class DeepMindSynthesiser : public juce::Synthesiser
+    {
+    public:
+        void setMpeEnabled(bool shouldBeEnabled);  // Lower zone, 15 member channels
+        bool isMpeEnabled() const { return mpeEnabled; }
+
+        void applyPitchBendRanges(); // Call after adding voices
+
+        void noteOn(int midiChannel, int midiNoteNumber, float velocity) override;
+        void handlePitchWheel(int midiChannel, int wheelValue) override;
+        void handleController(int midiChannel, int controllerNumber, int controllerValue) override;
+        void handleChannelPressure(int midiChannel, int channelPressureValue) override;
+
+    protected:
+        void handleMidiEvent(const juce::MidiMessage& message) override;
+
+    private:
+        void updateFromZoneLayout();
+        bool isMasterChannel(int midiChannel) const;
+        void storeController(int midiChannel, int controllerNumber, int controllerValue);
+
+        // Held controller values per MIDI channel (index 1-16), 0..1
+        struct ChannelExpression
+        {
+            float modWheel = 0.0f; // CC 1
+            float timbre = 0.0f;   // CC 74
+            float pressure = 0.0f; // Channel pressure
+        };
+        std::array<ChannelExpression, 17> channelExpression {};
+
+        juce::MPEZoneLayout zoneLayout;
+        bool mpeEnabled = false;
+        int lowerMaster = 0, upperMaster = 0; // 0 = zone inactive
+
+        float noteBendRange = 2.0f;   // Semitones, per channel (MPE default 48)
+        float masterBendRange = 2.0f; // Semitones, master channel
+    };
+}
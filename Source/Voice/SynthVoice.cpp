@@ -1,5 +1,9 @@
 #include "SynthVoice.h"
+#include "../DSP/FastMath.h"
+#include "../DSP/Kernels/Kernels.h"
+#include "../DSP/TraceRecorder.h"
 #include <cmath>
+#include <iterator>
 
 using namespace voice;
 
@@ -17,7 +21,7 @@ void SynthVoice::setCurrentPlaybackSampleRate (double newRate)
     {
         juce::dsp::ProcessSpec spec;
         spec.sampleRate = newRate;
-        spec.maximumBlockSize = 512;
+        spec.maximumBlockSize = tileSamples; // Voices only ever process one tile at a time
         spec.numChannels = 1;
         
         // LFOs don't need prepare, just sample rate
@@ -28,9 +32,15 @@ void SynthVoice::setCurrentPlaybackSampleRate (double newRate)
         for(auto& o : osc1) o.prepare(spec);
         for(auto& o : osc2) o.prepare(spec);
         filter.prepare(spec); 
+        rightFilter.prepare(spec);
         
-        driftGen.prepare(newRate);
+        driftBank.prepare(newRate);
         ctrlSeq.prepare(newRate);
+        
+        silenceSamplesToEnd = juce::jmax(1, (int)(silenceHoldSeconds * newRate));
+        
+        for (auto* smoothed : { &pitchBend, &masterPitchBend, &modWheel, &pressure, &timbre })
+            smoothed->reset(newRate, expressionSmoothingSeconds);
     }
 }
 
@@ -52,28 +62,21 @@ void SynthVoice::startNote(int midiNoteNumber, float velocity, juce::Synthesiser
     lfo1Random = 0.0f;
     lfo2Random = 0.0f;
     noteSeconds = 0.0;
+    silentSampleCount = 0;
     
-    // Spread Logic
-    // Manual: "+/- 50 cents spread over voices"
-    // currentUnisonDetune is 0..1 representing 0..50 cents (0.5 semitones)
-    float maxDetuneSemitones = currentUnisonDetune * 0.5f; 
+    // Expression starts where the channel is (no glide from the previous note)
+    pitchBend.setCurrentAndTargetValue(wheelToBend(currentPitchWheelPosition));
+    modWheel.setCurrentAndTargetValue(heldModWheel);
+    timbre.setCurrentAndTargetValue(heldTimbre);
+    pressure.setCurrentAndTargetValue(heldPressure);
+    
+    // Spread Logic (cached ratios per unison layer, 1.0 for unused layers)
+    updateSpreadRatios();
     
     for (int i = 0; i < MaxUnison; ++i)
     {
-        float ratio = 1.0f;
-        if (i < unisonMode && unisonMode > 1)
-        {
-            // Generic Spread Formula (Even/Odd compatible)
-            // Maps i=[0..N-1] to [-1..1]
-            float norm = (float)i / (float)(unisonMode - 1); // 0.0 to 1.0
-            float pan = norm * 2.0f - 1.0f;                  // -1.0 to 1.0
-            
-            float spread = pan * maxDetuneSemitones;
-            ratio = std::pow(2.0f, spread / 12.0f);
-        }
-        
-        osc1[i].setFrequency(frequency * ratio);
-        osc2[i].setFrequency(frequency * ratio); 
+        osc1[i].setFrequency(frequency * spreadRatios[i]);
+        osc2[i].setFrequency(frequency * spreadRatios[i]); 
     }
     
     envVca.noteOn();
@@ -95,10 +98,8 @@ void SynthVoice::stopNote(float velocity, bool allowTailOff)
 void SynthVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
 {
     if (!isVoiceActive()) return;
+    DEEPMIND_TRACE_ZONE("voice");
 
-    juce::dsp::AudioBlock<float> block(outputBuffer);
-    auto subBlock = block.getSubBlock(startSample, numSamples);
-    
     // 1. Update Modulators (Manual Phase Accumulator)
     DeepMindDSP::ModSources modSrc;
     
@@ -167,15 +168,9 @@ void SynthVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int sta
     */
     
     // Envelope Mod (Sample one point)
-    // 1. Pre-calculate VCA Envelope (Audio Rate) to buffer
-    juce::AudioBuffer<float> vcaEnvBuf(1, numSamples);
-    auto* vcaWrite = vcaEnvBuf.getWritePointer(0);
-    
-    for(int k=0; k<numSamples; ++k)
-    {
-        float val = envVca.getNextSample();
-        vcaWrite[k] = applyCurve(val, vcaCurve);
-    }
+    // 1. VCA Envelope is audio rate and is generated tile by tile below.
+    // Its first sample is taken here because the Mod Matrix needs it.
+    float firstVca = applyCurve(envVca.getNextSample(), vcaCurve);
     
     // 2. Sample VCF/Mod Envelopes (Control Rate - Start of Block)
     float rawMod = envMod.getNextSample(); // Sample 0
@@ -189,7 +184,7 @@ void SynthVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int sta
     
     modSrc.envMod = applyCurve(rawMod, modCurve);
     modSrc.envVcf = applyCurve(rawVcf, vcfCurve);
-    modSrc.envVca = vcaWrite[0]; // Use first sample for Mod Matrix
+    modSrc.envVca = firstVca; // Use first sample for Mod Matrix
     
     // Control Sequencer
     float seqVal = ctrlSeq.getNextSample();
@@ -198,7 +193,13 @@ void SynthVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int sta
     modSrc.ctrlSeq = seqVal;
     
     modSrc.velocity = currentVelocity; 
-    modSrc.modWheel = currentModWheel; 
+    
+    // Expression (value at the end of this sub-block)
+    modSrc.pitchBend = pitchBend.skip(numSamples);
+    modSrc.modWheel = modWheel.skip(numSamples);
+    modSrc.pressure = pressure.skip(numSamples);
+    modSrc.timbre = timbre.skip(numSamples);
+    float bendSemitones = modSrc.pitchBend * pitchBendRange + masterPitchBend.skip(numSamples) * masterPitchBendRange;
     
     DeepMindDSP::ModDestinations modDst;
     modMatrix.process(modSrc, modDst);
@@ -211,281 +212,490 @@ void SynthVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int sta
     // We should re-calc freq per voice if we want full mod accuracy.
     // Simplified: modulation affects the ratio.
     
-    float pitchRatio1 = 1.0f;
-    if (modDst.osc1Pitch != 0.0f) pitchRatio1 = std::pow(2.0f, (modDst.osc1Pitch * 12.0f) / 12.0f); 
+    // Pitch bend is folded into the same exponent (one exp2 per sub-block, not per event)
+    float pitchRatio1 = DeepMindDSP::FastMath::exp2(modDst.osc1Pitch + bendSemitones / 12.0f);
+    float pitchRatio2 = DeepMindDSP::FastMath::exp2(modDst.osc2Pitch + bendSemitones / 12.0f);
 
-    float pitchRatio2 = 1.0f;
-    if (modDst.osc2Pitch != 0.0f) pitchRatio2 = std::pow(2.0f, (modDst.osc2Pitch * 12.0f) / 12.0f);
+    // Analog Drift (Slop): every oscillator and the filter drift independently.
+    // All lanes advance in one vectorised pass; pitch drift is +/- 20 cents max.
+    const float* drift = driftBank.process(numSamples);
+    float driftSemitones[MaxUnison * 2];
+    float driftRatios[MaxUnison * 2];
+    for (int i = 0; i < MaxUnison * 2; ++i)
+        driftSemitones[i] = drift[DeepMindDSP::DriftBank::Osc1Lane + i] * driftAmount * 0.2f;
+    DeepMindDSP::FastMath::semitonesToRatio(driftSemitones, driftRatios, MaxUnison * 2);
 
-    // Apply pitch updates + Unison Spread (Recalculate or store offsets? Simpler to store offsets)
-    // Quick Fix: Re-run spread logic here or assume 'osc[i].setFrequency' overwrote it?
-    // 'setFrequency' overwrites. So we MUST include spread here or store base per voice.
-    // Optimization: Just apply mod to the *current* freq? No, osc state doesn't expose getFreq easily.
-    // Let's re-calc spread ratios here. It's cheap.
-    
-    float maxDetuneSemitones = currentUnisonDetune * 0.5f; 
+    // Apply pitch updates + Unison Spread + Drift.
+    // 'setFrequency' overwrites, so the spread goes in here too (ratios cached, see updateSpreadRatios)
+    updateSpreadRatios();
 
     for (int i=0; i < unisonMode; ++i)
     {
-         float spread = 0.0f;
-         if (unisonMode > 1)
-         {
-             float norm = (float)i / (float)(unisonMode - 1); 
-             float pan = norm * 2.0f - 1.0f;
-             spread = pan * maxDetuneSemitones;
-         }
-         
-         float spreadRatio = std::pow(2.0f, spread / 12.0f);
-         
-         osc1[i].setFrequency(static_cast<float>(currentBaseFrequency) * pitchRatio1 * spreadRatio);
-         osc2[i].setFrequency(static_cast<float>(currentBaseFrequency) * pitchRatio2 * spreadRatio);
+         float layerFrequency = static_cast<float>(currentBaseFrequency) * spreadRatios[i];
+         osc1[i].setFrequency(layerFrequency * pitchRatio1 * driftRatios[i]);
+         osc2[i].setFrequency(layerFrequency * pitchRatio2 * driftRatios[MaxUnison + i]);
     }
     
-    // Apply Global Drift (Slop)
-    // Drift affects Pitch (+/- 20 cents max) and slightly Filter (-5% max)
-    float driftVal = driftGen.getNextSample() * driftAmount; 
-    float driftPitchRatio = std::pow(2.0f, (driftVal * 0.2f) / 12.0f); // +/- 20 cents
-    
-    // Apply to all unison voices (could be per-voice if we had array of drifts, but 12 drifts is CPU heavy?)
-    // Actually SynthVoice IS one voice (with unison stack). So one drift per KEY is correct.
-    // Ideally each unison stack voice drifts differently, but 1 drift per Key is a good start.
-    
-    for(auto& o : osc1) o.setFrequency(o.getFrequency() * driftPitchRatio);
-    for(auto& o : osc2) o.setFrequency(o.getFrequency() * driftPitchRatio);
-    
     // Cutoff Drift
-    float modulatedCutoff = filter.getCutoff() + (modDst.vcfCutoff * 5000.0f); 
-    modulatedCutoff *= (1.0f + (driftVal * 0.05f)); // +/- 5% freq variation 
+    float modulatedCutoff = baseCutoff + (modDst.vcfCutoff * 5000.0f); 
+    modulatedCutoff *= (1.0f + (drift[DeepMindDSP::DriftBank::FilterLane] * driftAmount * 0.05f)); // +/- 5% freq variation 
     
     // Apply Key Tracking
     if (vcfKybdAmount != 0.0f)
     {
-        float keyTrackRatio = std::pow(2.0f, (float)(currentNoteNumber - 60) / 12.0f * vcfKybdAmount);
+        float keyTrackRatio = DeepMindDSP::FastMath::semitonesToRatio((float)(currentNoteNumber - 60) * vcfKybdAmount);
         modulatedCutoff *= keyTrackRatio;
     }
     
     if (modulatedCutoff < 20.0f) modulatedCutoff = 20.0f;
     if (modulatedCutoff > 20000.0f) modulatedCutoff = 20000.0f;
     filter.setCutoff(modulatedCutoff);
+    rightFilter.setCutoff(modulatedCutoff);
     
-    // 3. Process Audio (Block)
-    // Summing Buffer
-    juce::AudioBuffer<float> sumBuffer(subBlock.getNumChannels(), subBlock.getNumSamples());
-    sumBuffer.clear();
-    juce::dsp::AudioBlock<float> sumBlock(sumBuffer);
+    // 3. Process Audio: filter type, layer count and routing are compile-time
+    // in the kernel (see renderTiles / selectRenderKernel)
+    const bool stereoUnison = allowStereoUnison && unisonMode > 1 && unisonWidth > 0.0f && outputBuffer.getNumChannels() > 1;
+    if (stereoUnison != stereoActive || renderKernel == nullptr)
+    {
+        if (stereoUnison)
+            rightFilter.reset(); // Don't resume from stale state
+        stereoActive = stereoUnison;
+        selectRenderKernel();
+    }
+
+    float* left = outputBuffer.getWritePointer(0, startSample);
+    float* right = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer(1, startSample) : nullptr;
+    float peak = (this->*renderKernel)(left, right, numSamples, firstVca);
+
+    // 7. Silence Tracking
+    // Long releases decay far below audibility before the ADSR reaches zero.
+    // Only releasing voices are candidates (key up and no pedal holding it).
+    if (!isKeyDown() && !isSustainPedalDown() && !isSostenutoPedalDown())
+    {
+        if (peak < silenceThresholdGain)
+            silentSampleCount += numSamples;
+        else
+            silentSampleCount = 0;
+        
+        if (silentSampleCount >= silenceSamplesToEnd)
+        {
+            envVca.reset();
+            envVcf.reset();
+            envMod.reset();
+        }
+    }
+    
+    // Check if note finished
+    if (!envVca.isActive())
+        clearCurrentNote();
+}
+
+//==============================================================================
+// Render kernels
+// One instantiation per filter type x layer count x routing, so the tile loop
+// has no runtime switches: layer loops have fixed trip counts (unrolled), the
+// gain and spread positions are constants and the filter call is inlined.
+template <DeepMindDSP::FilterType Type, int Layers, bool Stereo>
+float SynthVoice::renderTiles(float* left, float* right, int numSamples, float firstVca)
+{
+    static_assert(Layers >= 1 && Layers <= MaxUnison, "Unsupported layer count");
+    static_assert(!Stereo || Layers > 1, "Stereo routing needs at least two layers");
+    
+    // Process in tiles.
+    // Every stage (osc -> filter -> VCA -> placement) runs back to back on a
+    // small stack tile, so intermediates stay in L1 whatever the host block size.
+    // Layers sum into 'stack'. With stereo width the layers are panned before the
+    // filter instead: each channel sums every layer, weighted 1 +/- width * its place
+    // in the spread (-1..1), and goes through its own filter. Each filter sees a
+    // whole stack at the mono stack's level, so the drive and the character match
+    // the mono sound (at width 0 both channels are exactly the mono stack).
 
     // Scaling Factor to prevent clipping with unison
     // Soft scaling: 1 osc = 1.0, 2 osc = 0.7, 4 osc = 0.5
-    float gain = 1.0f / std::sqrt((float)unisonMode);
+    const float gain = 1.0f / std::sqrt((float)Layers);
+    float peak = 0.0f;
+    const auto& kernels = DeepMindDSP::Kernels::get(); // Best ISA for this CPU
 
-    for (int i=0; i < unisonMode; ++i)
+    for (int tileStart = 0; tileStart < numSamples; tileStart += tileSamples)
     {
-        // Temp buffer for this voice
-        juce::AudioBuffer<float> voiceBuf(subBlock.getNumChannels(), subBlock.getNumSamples());
-        voiceBuf.clear();
-        juce::dsp::AudioBlock<float> voiceBlock(voiceBuf);
+        const int n = juce::jmin(tileSamples, numSamples - tileStart);
         
-        osc1[i].processBlock(voiceBlock);
-        osc2[i].processBlock(voiceBlock); // Note: Osc2 adds to Osc1 in buffer? Needs check.
+        float stack[tileSamples];      // Left channel when stereo
+        float stackRight[tileSamples]; // Stereo only
+        float vca[tileSamples];
         
-        // DeepMindOsc::processBlock REPLACES or ADDS?
-        // Checking DeepMindOsc.h/cpp... usually replaces.
-        // Wait, 'osc1.processBlock' and 'osc2.processBlock' were called sequentially on 'subBlock'.
-        // That implies they were overwriting each other or mixing?
-        // Standard juce::dsp::Oscillator replaces.
-        // If DeepMindOsc uses juce::dsp::Oscillator::process, it replaces.
-        // !!! BUG IN PREVIOUS CODE !!!
-        // Line 136/137: osc1.process(blk); osc2.process(blk); -> Osc2 overwrites Osc1.
-        // I need to mix them.
+        // VCA envelope for this tile
+        int k = 0;
+        if (tileStart == 0) vca[k++] = firstVca;
+        for (; k < n; ++k)
+            vca[k] = applyCurve(envVca.getNextSample(), vcaCurve);
         
-        // Fix: Mix Osc1 and Osc2 into voiceBuf
-        osc1[i].processBlock(voiceBlock); // Writes Osc1
-
-        // Mix Osc2
-        juce::AudioBuffer<float> osc2Buf(subBlock.getNumChannels(), subBlock.getNumSamples());
-        osc2Buf.clear();
-        juce::dsp::AudioBlock<float> osc2Block(osc2Buf);
-        osc2[i].processBlock(osc2Block);
-
-        // Add Osc2 to VoiceBuf
-        for(int ch=0; ch<voiceBuf.getNumChannels(); ++ch)
-            voiceBuf.addFrom(ch, 0, osc2Buf, ch, 0, osc2Buf.getNumSamples());
-
-        // Add VoiceBuf to SumBuf
-        for(int ch=0; ch<sumBuffer.getNumChannels(); ++ch)
-            sumBuffer.addFrom(ch, 0, voiceBuf, ch, 0, voiceBuf.getNumSamples(), gain);
+        juce::FloatVectorOperations::clear(stack, n);
+        if constexpr (Stereo)
+            juce::FloatVectorOperations::clear(stackRight, n);
+
+        for (int i = 0; i < Layers; ++i)
+        {
+            if constexpr (!Stereo)
+            {
+                // Osc1 + Osc2 straight into the sum
+                osc1[i].process(stack, n, gain);
+                osc2[i].process(stack, n, gain);
+            }
+            else
+            {
+                float layer[tileSamples];
+                juce::FloatVectorOperations::clear(layer, n);
+                osc1[i].process(layer, n, gain);
+                osc2[i].process(layer, n, gain);
+
+                const float position = (float)i / (float)(Layers - 1) * 2.0f - 1.0f;
+                kernels.addScaled(stack, layer, 1.0f + unisonWidth * position, n);
+                kernels.addScaled(stackRight, layer, 1.0f - unisonWidth * position, n);
+            }
+        }
+
+        // 4. Filter
+        {
+            DEEPMIND_TRACE_ZONE("voice: filter");
+            filter.processAs<Type>(stack, n);
+            if constexpr (Stereo)
+                rightFilter.processAs<Type>(stackRight, n);
+        }
+
+        // 5. VCA
+        kernels.multiply(stack, vca, n);
+        if constexpr (Stereo)
+            kernels.multiply(stackRight, vca, n);
+
+        // 6. Output: the only stage that touches the buffer, and it adds (other
+        // voices are already in there)
+        float tilePeak = kernels.peak(stack, n);
+        kernels.add(left + tileStart, stack, n);
+        
+        if constexpr (Stereo)
+        {
+            kernels.add(right + tileStart, stackRight, n);
+            tilePeak = juce::jmax(tilePeak, kernels.peak(stackRight, n)); // Peak for silence tracking
+        }
+        else if (right != nullptr)
+        {
+            kernels.add(right + tileStart, stack, n);
+        }
+        
+        peak = juce::jmax(peak, tilePeak);
     }
     
-    // Copy sum back to subBlock
-    subBlock.copyFrom(sumBlock);
+    return peak;
+}
+
+namespace
+{
+    // The layer counts polyphony_mode can produce (see updateParameters)
+    constexpr int layerCounts[] = { 1, 2, 3, 4, 6, 12 };
+    constexpr int numLayerCounts = (int)std::size(layerCounts);
+    constexpr int numFilterTypes = 4;
+}
+
+template <DeepMindDSP::FilterType Type, bool Stereo>
+std::array<SynthVoice::RenderKernel, 6> SynthVoice::kernelsFor()
+{
+    // Mono routing for one layer stands in for the (never selected) 1-layer stereo slot
+    return { &SynthVoice::renderTiles<Type, 1, false>,
+             &SynthVoice::renderTiles<Type, 2, Stereo>,
+             &SynthVoice::renderTiles<Type, 3, Stereo>,
+             &SynthVoice::renderTiles<Type, 4, Stereo>,
+             &SynthVoice::renderTiles<Type, 6, Stereo>,
+             &SynthVoice::renderTiles<Type, 12, Stereo> };
+}
+
+void SynthVoice::selectRenderKernel()
+{
+    using FT = DeepMindDSP::FilterType;
+    
+    // [filter type * 2 + stereo][layer count slot]
+    static const std::array<std::array<RenderKernel, numLayerCounts>, numFilterTypes * 2> kernels = {
+        kernelsFor<FT::Jupiter, false>(),  kernelsFor<FT::Jupiter, true>(),
+        kernelsFor<FT::MS20, false>(),     kernelsFor<FT::MS20, true>(),
+        kernelsFor<FT::Acid303, false>(),  kernelsFor<FT::Acid303, true>(),
+        kernelsFor<FT::DeepMind, false>(), kernelsFor<FT::DeepMind, true>()
+    };
+    
+    // Largest supported stack within both the patch and the quality cap
+    const int wantedLayers = juce::jmin(unisonParam, maxUnisonLayers);
+    int slot = 0;
+    while (slot < numLayerCounts - 1 && layerCounts[slot + 1] <= wantedLayers)
+        ++slot;
+    unisonMode = layerCounts[slot];
     
-    // 4. Filter
-    filter.process(subBlock);
+    int type = juce::jlimit(0, numFilterTypes - 1, (int)filter.getType());
+    renderKernel = kernels[(size_t)(type * 2 + (stereoActive ? 1 : 0))][(size_t)slot];
+}
+
+void SynthVoice::setQualityLimits(int newMaxUnisonLayers, bool shouldAllowStereoUnison)
+{
+    if (newMaxUnisonLayers == maxUnisonLayers && shouldAllowStereoUnison == allowStereoUnison) return;
     
-    // 5. VCA
-    // Multiply output by pre-calculated VCA buffer
-    // envVca.applyEnvelopeToBuffer(outputBuffer, startSample, numSamples); // OLD
+    maxUnisonLayers = juce::jlimit(1, MaxUnison, newMaxUnisonLayers);
+    allowStereoUnison = shouldAllowStereoUnison;
+    selectRenderKernel(); // Routing is re-checked at the next render
+}
+
+void SynthVoice::updateSpreadRatios()
+{
+    if (unisonMode == spreadRatiosMode && currentUnisonDetune == spreadRatiosDetune) return;
+    spreadRatiosMode = unisonMode;
+    spreadRatiosDetune = currentUnisonDetune;
     
-    auto* vcaRead = vcaEnvBuf.getReadPointer(0);
-    for (int ch = 0; ch < outputBuffer.getNumChannels(); ++ch)
+    // Manual: "+/- 50 cents spread over voices"
+    // currentUnisonDetune is 0..1 representing 0..50 cents (0.5 semitones)
+    float maxDetuneSemitones = currentUnisonDetune * 0.5f;
+    float spreadSemitones[MaxUnison] = {};
+    
+    if (unisonMode > 1)
     {
-        juce::FloatVectorOperations::multiply(outputBuffer.getWritePointer(ch, startSample), 
-                                              vcaRead, numSamples);
+        for (int i = 0; i < juce::jmin(unisonMode, MaxUnison); ++i)
+        {
+            // Generic Spread Formula (Even/Odd compatible)
+            // Maps i=[0..N-1] to [-1..1]
+            float norm = (float)i / (float)(unisonMode - 1); // 0.0 to 1.0
+            float pan = norm * 2.0f - 1.0f;                  // -1.0 to 1.0
+            spreadSemitones[i] = pan * maxDetuneSemitones;
+        }
     }
-
     
+    // All layers in one (vectorisable) pass
+    DeepMindDSP::FastMath::semitonesToRatio(spreadSemitones, spreadRatios, MaxUnison);
+}
 
-    
-    // Check if note finished
-    if (!envVca.isActive())
-        clearCurrentNote();
+void SynthVoice::setSilenceThreshold(float thresholdDb, double holdSeconds)
+{
+    silenceThresholdGain = juce::Decibels::decibelsToGain(thresholdDb);
+    silenceHoldSeconds = holdSeconds;
+    silenceSamplesToEnd = juce::jmax(1, (int)(holdSeconds * currentSampleRate));
 }
 
-void SynthVoice::updateParameters(juce::AudioProcessorValueTreeState* apvts)
+juce::uint32 SynthVoice::groupForParameter(const juce::String& id)
 {
-    if (apvts == nullptr) return;
+    for (auto* env : { "vca_", "vcf_", "mod_" })
+        for (auto* stage : { "attack", "decay", "sustain", "release", "curve" })
+            if (id == juce::String(env) + stage)
+                return envelopeGroup;
+    
+    if (id == "dco1_pwm")                                      return oscillatorGroup;
+    if (id.startsWith("vcf_"))                                 return filterGroup;
+    if (id.startsWith("mod_slot_"))                            return modMatrixGroup;
+    if (id.startsWith("lfo1_") || id.startsWith("lfo2_"))      return lfoGroup;
+    if (id == "polyphony_mode" || id.startsWith("unison_"))    return unisonGroup;
+    if (id == "drift")                                         return driftGroup;
+    if (id.startsWith("seq_"))                                 return sequencerGroup;
+    return 0;
+}
 
-    // --- Oscillators ---
-    auto* dco1Pwm = apvts->getRawParameterValue("dco1_pwm");
-    // Handled in Unison block below
-    // if (dco1Pwm) osc1.setShape(*dco1Pwm);
+void SynthVoice::attachParameters(const data::StateSerializer& layout)
+{
+    auto get = [&layout](const juce::String& id) { return layout.getLiveValue(id); };
     
-    // --- Filters ---
-    auto* cutoff = apvts->getRawParameterValue("vcf_freq");
-    if (cutoff) filter.setCutoff(*cutoff);
-    
-    auto* res = apvts->getRawParameterValue("vcf_res");
-    if (res) filter.setResonance(*res);
-    
-    auto* kybd = apvts->getRawParameterValue("vcf_kybd");
-    if (kybd) vcfKybdAmount = *kybd;
-    
-    auto* type = apvts->getRawParameterValue("vcf_type");
-    if (type) filter.setType(static_cast<DeepMindDSP::FilterType>((int)*type));
-
-    // --- Envelopes (Using setParameters for ADSR) ---
-    juce::ADSR::Parameters vcaParams;
-    vcaParams.attack = *apvts->getRawParameterValue("vca_attack");
-    vcaParams.decay = *apvts->getRawParameterValue("vca_decay");
-    vcaParams.sustain = *apvts->getRawParameterValue("vca_sustain");
-    vcaParams.release = *apvts->getRawParameterValue("vca_release");
-    envVca.setParameters(vcaParams);
-    
-    auto* vcaC = apvts->getRawParameterValue("vca_curve");
-    if (vcaC) vcaCurve = *vcaC;
-    
-    // VCF
-    juce::ADSR::Parameters vcfParams;
-    vcfParams.attack = *apvts->getRawParameterValue("vcf_attack");
-    vcfParams.decay = *apvts->getRawParameterValue("vcf_decay");
-    vcfParams.sustain = *apvts->getRawParameterValue("vcf_sustain");
-    vcfParams.release = *apvts->getRawParameterValue("vcf_release");
-    envVcf.setParameters(vcfParams);
-
-    auto* vcfC = apvts->getRawParameterValue("vcf_curve");
-    if (vcfC) vcfCurve = *vcfC;
-
-    // MOD
-    juce::ADSR::Parameters modParams;
-    modParams.attack = *apvts->getRawParameterValue("mod_attack");
-    modParams.decay = *apvts->getRawParameterValue("mod_decay");
-    modParams.sustain = *apvts->getRawParameterValue("mod_sustain");
-    modParams.release = *apvts->getRawParameterValue("mod_release");
-    envMod.setParameters(modParams);
-
-    auto* modC = apvts->getRawParameterValue("mod_curve");
-    if (modC) modCurve = *modC;
+    params.dco1Pwm = get("dco1_pwm");
+    
+    params.vcfFreq = get("vcf_freq");
+    params.vcfRes = get("vcf_res");
+    params.vcfKybd = get("vcf_kybd");
+    params.vcfType = get("vcf_type");
+    params.vcfTwoPole = get("vcf_2pole");
+    
+    const char* stages[] = { "attack", "decay", "sustain", "release" };
+    for (int i = 0; i < 4; ++i)
+    {
+        params.vcaEnv[i] = get(juce::String("vca_") + stages[i]);
+        params.vcfEnv[i] = get(juce::String("vcf_") + stages[i]);
+        params.modEnv[i] = get(juce::String("mod_") + stages[i]);
+    }
+    params.vcaCurve = get("vca_curve");
+    params.vcfCurve = get("vcf_curve");
+    params.modCurve = get("mod_curve");
     
-    // --- Mod Matrix ---
-    // Iterate 8 slots
     for (int i = 0; i < 8; ++i)
     {
         juce::String prefix = "mod_slot_" + juce::String(i + 1);
-        auto* src = apvts->getRawParameterValue(prefix + "_src");
-        auto* dst = apvts->getRawParameterValue(prefix + "_dst");
-        auto* amt = apvts->getRawParameterValue(prefix + "_amt");
-        
-        if (src && dst && amt)
-        {
-            modMatrix.setSlot(i, (int)*src, (int)*dst, *amt);
-        }
+        params.modSlots[i][0] = get(prefix + "_src");
+        params.modSlots[i][1] = get(prefix + "_dst");
+        params.modSlots[i][2] = get(prefix + "_amt");
     }
     
-    // --- LFOs ---
-    auto* l1r = apvts->getRawParameterValue("lfo1_rate");
-    auto* l1d = apvts->getRawParameterValue("lfo1_delay");
-    auto* l1s = apvts->getRawParameterValue("lfo1_shape");
-    if (l1r) currentLfoOsc1Rate = *l1r;
-    if (l1d) lfoOsc1Delay = *l1d;
-    if (l1s) lfo1Shape = static_cast<LfoShape>((int)*l1s);
-    
-    auto* l2r = apvts->getRawParameterValue("lfo2_rate");
-    auto* l2d = apvts->getRawParameterValue("lfo2_delay");
-    auto* l2s = apvts->getRawParameterValue("lfo2_shape");
-    if (l2r) currentLfoOsc2Rate = *l2r;
-    if (l2d) lfoOsc2Delay = *l2d;
-    if (l2s) lfo2Shape = static_cast<LfoShape>((int)*l2s);
-
-    // --- Unison ---
-    // --- Unison / Polyphony ---
-    auto* pMode = apvts->getRawParameterValue("polyphony_mode");
-    auto* uDet = apvts->getRawParameterValue("unison_detune");
+    params.lfo1Rate = get("lfo1_rate");
+    params.lfo1Delay = get("lfo1_delay");
+    params.lfo1Shape = get("lfo1_shape");
+    params.lfo2Rate = get("lfo2_rate");
+    params.lfo2Delay = get("lfo2_delay");
+    params.lfo2Shape = get("lfo2_shape");
+    
+    params.polyphonyMode = get("polyphony_mode");
+    params.unisonDetune = get("unison_detune");
+    params.unisonWidth = get("unison_width");
+    params.drift = get("drift");
+    
+    params.seqRate = get("seq_rate");
+    params.seqSlew = get("seq_slew");
+    params.seqSteps = get("seq_steps");
+    params.seqSwing = get("seq_swing");
+    for (int i = 0; i < 32; ++i)
+        params.seqSteps32[i] = get("seq_step_" + juce::String(i + 1));
+    
+    updateParameters(allGroups);
+}
+
+void SynthVoice::updateParameters(juce::uint32 groups)
+{
+    const auto& p = params;
     
-    if (pMode) 
+    // --- Oscillators ---
+    // Shape goes to every unison layer
+    if ((groups & oscillatorGroup) && p.dco1Pwm)
+        for (auto& o : osc1) o.setShape(*p.dco1Pwm);
+    
+    // --- Filters ---
+    // (Cutoff is set per block in renderNextBlock from baseCutoff + modulation)
+    if (groups & filterGroup)
     {
-        int idx = (int)*pMode;
-        // Map Selection to Voice Count
-        // 0:Poly, 1:U2, 2:U3, 3:U4, 4:U6, 5:U12, 6:Mono, 7:M2, 8:M3, 9:M4, 10:M6, 11:P6, 12:P8
-        static const int voiceMap[] = { 1, 2, 3, 4, 6, 12, 1, 2, 3, 4, 6, 1, 1 };
+        if (p.vcfFreq) baseCutoff = *p.vcfFreq;
+        if (p.vcfRes) { filter.setResonance(*p.vcfRes); rightFilter.setResonance(*p.vcfRes); }
+        if (p.vcfKybd) vcfKybdAmount = *p.vcfKybd;
         
-        if (idx >= 0 && idx < 13)
-            unisonMode = voiceMap[idx];
-        else
-            unisonMode = 1;
+        if (p.vcfType)
+        {
+            filter.setType(static_cast<DeepMindDSP::FilterType>((int)*p.vcfType));
+            rightFilter.setType(static_cast<DeepMindDSP::FilterType>((int)*p.vcfType));
+        }
+        
+        if (p.vcfTwoPole) { filter.setTwoPole(*p.vcfTwoPole > 0.5f); rightFilter.setTwoPole(*p.vcfTwoPole > 0.5f); }
     }
-    if (uDet) currentUnisonDetune = *uDet;
-    
-    // Drift
-    auto* drift = apvts->getRawParameterValue("drift");
-    if (drift) driftAmount = *drift;
 
-    // Propagate shapes to all unison voices
-    if (dco1Pwm) {
-        for(auto& o : osc1) o.setShape(*dco1Pwm);
+    // --- Envelopes ---
+    if (groups & envelopeGroup)
+    {
+        auto adsr = [](Param const (&stage)[4]) {
+            juce::ADSR::Parameters result;
+            if (stage[0]) result.attack = *stage[0];
+            if (stage[1]) result.decay = *stage[1];
+            if (stage[2]) result.sustain = *stage[2];
+            if (stage[3]) result.release = *stage[3];
+            return result;
+        };
+        
+        envVca.setParameters(adsr(p.vcaEnv));
+        envVcf.setParameters(adsr(p.vcfEnv));
+        envMod.setParameters(adsr(p.modEnv));
+        
+        if (p.vcaCurve) vcaCurve = *p.vcaCurve;
+        if (p.vcfCurve) vcfCurve = *p.vcfCurve;
+        if (p.modCurve) modCurve = *p.modCurve;
     }
     
-    // Control Sequencer Params
-    auto* seqRate = apvts->getRawParameterValue("seq_rate");
-    auto* seqSlew = apvts->getRawParameterValue("seq_slew");
-    auto* seqSteps = apvts->getRawParameterValue("seq_steps");
-    auto* seqSwing = apvts->getRawParameterValue("seq_swing");
-    
-    if (seqRate) ctrlSeq.setRate(*seqRate);
-    if (seqSlew) ctrlSeq.setSlew(*seqSlew);
-    if (seqSteps) ctrlSeq.setLength((int)*seqSteps);
-    if (seqSwing) ctrlSeq.setSwing(*seqSwing);
-    
-    // Cache pointers if empty
-    if (seqStepParams.empty()) {
-        for(int i=1; i<=32; ++i) {
-            seqStepParams.push_back(apvts->getRawParameterValue("seq_step_" + juce::String(i)));
+    // --- Mod Matrix ---
+    if (groups & modMatrixGroup)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            const auto& slot = p.modSlots[i];
+            if (slot[0] && slot[1] && slot[2])
+                modMatrix.setSlot(i, (int)*slot[0], (int)*slot[1], *slot[2]);
         }
     }
     
-    // Update steps
-    for(int i=0; i<32; ++i) {
-        if (i < seqStepParams.size() && seqStepParams[i])
-            ctrlSeq.setStepValue(i, *(seqStepParams[i]));
+    // --- LFOs ---
+    if (groups & lfoGroup)
+    {
+        if (p.lfo1Rate) currentLfoOsc1Rate = *p.lfo1Rate;
+        if (p.lfo1Delay) lfoOsc1Delay = *p.lfo1Delay;
+        if (p.lfo1Shape) lfo1Shape = static_cast<LfoShape>((int)*p.lfo1Shape);
+        
+        if (p.lfo2Rate) currentLfoOsc2Rate = *p.lfo2Rate;
+        if (p.lfo2Delay) lfoOsc2Delay = *p.lfo2Delay;
+        if (p.lfo2Shape) lfo2Shape = static_cast<LfoShape>((int)*p.lfo2Shape);
     }
 
-} // <--- Added closing brace
+    // --- Unison / Polyphony ---
+    if (groups & unisonGroup)
+    {
+        if (p.polyphonyMode)
+        {
+            int idx = (int)*p.polyphonyMode;
+            // Map Selection to Voice Count
+            // 0:Poly, 1:U2, 2:U3, 3:U4, 4:U6, 5:U12, 6:Mono, 7:M2, 8:M3, 9:M4, 10:M6, 11:P6, 12:P8
+            static const int voiceMap[] = { 1, 2, 3, 4, 6, 12, 1, 2, 3, 4, 6, 1, 1 };
+            
+            if (idx >= 0 && idx < 13)
+                unisonParam = voiceMap[idx];
+            else
+                unisonParam = 1;
+        }
+        if (p.unisonDetune) currentUnisonDetune = *p.unisonDetune;
+        if (p.unisonWidth) unisonWidth = *p.unisonWidth;
+    }
+    
+    // Filter type / layer count may have changed (routing is re-checked per block)
+    if (groups & (filterGroup | unisonGroup))
+        selectRenderKernel();
+    
+    // --- Drift ---
+    if ((groups & driftGroup) && p.drift)
+        driftAmount = *p.drift;
+    
+    // --- Control Sequencer ---
+    if (groups & sequencerGroup)
+    {
+        if (p.seqRate) ctrlSeq.setRate(*p.seqRate);
+        if (p.seqSlew) ctrlSeq.setSlew(*p.seqSlew);
+        if (p.seqSteps) ctrlSeq.setLength((int)*p.seqSteps);
+        if (p.seqSwing) ctrlSeq.setSwing(*p.seqSwing);
+        
+        for (int i = 0; i < 32; ++i)
+            if (p.seqSteps32[i])
+                ctrlSeq.setStepValue(i, *p.seqSteps32[i]);
+    }
+}
 
 void SynthVoice::pitchWheelMoved(int newPitchWheelValue)
 {
-    // TODO: Implement pitch bend
+    pitchBend.setTargetValue(wheelToBend(newPitchWheelValue));
+}
+
+void SynthVoice::masterPitchWheelMoved(int newPitchWheelValue)
+{
+    masterPitchBend.setTargetValue(wheelToBend(newPitchWheelValue));
+}
+
+void SynthVoice::setPitchBendRanges(float noteSemitones, float masterSemitones)
+{
+    pitchBendRange = noteSemitones;
+    masterPitchBendRange = masterSemitones;
+}
+
+void SynthVoice::setHeldExpression(float modWheelValue, float timbreValue, float pressureValue)
+{
+    heldModWheel = modWheelValue;
+    heldTimbre = timbreValue;
+    heldPressure = pressureValue;
 }
 
 void SynthVoice::controllerMoved(int controllerNumber, int newControllerValue)
 {
-    // TODO: Implement other controllers
+    switch (controllerNumber)
+    {
+        case 1:  modWheel.setTargetValue(newControllerValue / 127.0f); break; // Mod Wheel
+        case 74: timbre.setTargetValue(newControllerValue / 127.0f); break;   // MPE Timbre / Slide
+        default: break;
+    }
+}
+
+void SynthVoice::channelPressureChanged(int newChannelPressureValue)
+{
+    pressure.setTargetValue(newChannelPressureValue / 127.0f);
+}
+
+void SynthVoice::aftertouchChanged(int newAftertouchValue)
+{
+    // Poly aftertouch drives the same per-voice pressure source
+    pressure.setTargetValue(newAftertouchValue / 127.0f);
 }
@@ -4,8 +4,9 @@
 #include "../DSP/Oscillators/DeepMindOsc.h"
 #include "../DSP/Filters/MultiFilter.h"
 #include "../DSP/Modulation/ModMatrix.h"
-#include "../DSP/DriftGen.h"
+#include "../DSP/DriftBank.h"
 #include "../DSP/Sequencing/ControlSequencer.h"
+#include "../Data/StateSerializer.h"
 
 namespace voice
 {
@@ -26,16 +27,66 @@ namespace voice
         void stopNote(float velocity, bool allowTailOff) override;
         void pitchWheelMoved(int newPitchWheelValue) override;
         void controllerMoved(int controllerNumber, int newControllerValue) override;
+        void channelPressureChanged(int newChannelPressureValue) override;
+        void aftertouchChanged(int newAftertouchValue) override;
+        
+        // MPE: bend on the zone's master channel (added to this note's own bend)
+        void masterPitchWheelMoved(int newPitchWheelValue);
+        void setPitchBendRanges(float noteSemitones, float masterSemitones);
+        void setHeldExpression(float modWheelValue, float timbreValue, float pressureValue); // Next startNote, 0..1
         void renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) override;
         
-        // Parameter update
-        void updateParameters(juce::AudioProcessorValueTreeState* apvts);
+        // Parameter update. attachParameters resolves every parameter the voice reads to
+        // its live value once (message thread, before the voice plays); updateParameters
+        // then only reads the cached atomics of the groups asked for, no ID strings or lookups.
+        enum ParameterGroup : juce::uint32
+        {
+            oscillatorGroup = 1u << 0,
+            filterGroup     = 1u << 1,
+            envelopeGroup   = 1u << 2,
+            modMatrixGroup  = 1u << 3,
+            lfoGroup        = 1u << 4,
+            unisonGroup     = 1u << 5,
+            driftGroup      = 1u << 6,
+            sequencerGroup  = 1u << 7,
+            allGroups       = 0xffu
+        };
+        static juce::uint32 groupForParameter(const juce::String& parameterID); // 0 = not read by voices
+        
+        void attachParameters(const data::StateSerializer& layout);
+        void updateParameters(juce::uint32 groups = allGroups);
+        
+        // Silence detection: a releasing voice whose output stays below the threshold
+        // for holdSeconds is ended early (default -96 dBFS, 50ms). Counted in samples,
+        // so it doesn't depend on how finely the block is split.
+        void setSilenceThreshold(float thresholdDb, double holdSeconds);
+        
+        // Quality governor limits (audio thread). Layers above the cap are dropped
+        // (the patch's stack is rounded down), stereo unison falls back to mono.
+        void setQualityLimits(int maxUnisonLayers, bool allowStereoUnison);
 
     private:
         static constexpr int MaxUnison = 12; // DeepMind 12 Hardware Limit
         DeepMindDSP::DeepMindOsc osc1[MaxUnison];
         DeepMindDSP::DeepMindOsc osc2[MaxUnison];
         DeepMindDSP::MultiFilter filter;
+        DeepMindDSP::MultiFilter rightFilter; // Stereo unison only ('filter' takes the left channel)
+        float baseCutoff = 1000.0f;          // vcf_freq before modulation
+        
+        // Render tile: all stages run on this many samples (on the stack) before moving on
+        static constexpr int tileSamples = 32;
+        
+        // Render kernels, specialised per filter type / layer count / routing.
+        // Returns the peak of the voice's output (silence tracking).
+        template <DeepMindDSP::FilterType Type, int Layers, bool Stereo>
+        float renderTiles(float* left, float* right, int numSamples, float firstVca);
+        
+        using RenderKernel = float (SynthVoice::*)(float*, float*, int, float);
+        RenderKernel renderKernel = nullptr;
+        
+        template <DeepMindDSP::FilterType Type, bool Stereo>
+        static std::array<RenderKernel, 6> kernelsFor();
+        void selectRenderKernel(); // On parameter / routing changes only
         DeepMindDSP::ModMatrix modMatrix;
         
         // Envelopes
@@ -57,8 +108,19 @@ namespace voice
         float currentLfoOsc2Rate = 1.0f;
         float lfoOsc2Delay = 0.0f;
         
-        int unisonMode = 1; // 1 = Off (1 voice), 2, 3, 4
+        int unisonParam = 1; // From polyphony_mode: 1 = Off (1 voice), 2, 3, 4, 6, 12
+        int unisonMode = 1;  // Layers actually rendered (unisonParam within the quality cap)
+        int maxUnisonLayers = MaxUnison;
+        bool allowStereoUnison = true;
         float currentUnisonDetune = 0.0f;
+        float unisonWidth = 0.5f;  // 0 = mono stack, 1 = layers spread hard L..R
+        bool stereoActive = false;
+        
+        // Unison spread as frequency ratios per layer, rebuilt only when mode/detune change
+        void updateSpreadRatios();
+        float spreadRatios[MaxUnison] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+        int spreadRatiosMode = 0;
+        float spreadRatiosDetune = -1.0f;
         
         // --- LFO Expansion ---
         enum class LfoShape { Sine, Triangle, Square, RampUp, RampDown, SampleHold, SampleGlide };
@@ -73,8 +135,21 @@ namespace voice
         float currentVelocity = 0.0f;
         double currentBaseFrequency = 440.0;
         
-        // Controllers
-        float currentModWheel = 0.0f; // CC 1
+        // Controllers / Expression
+        // MIDI only sets targets; renderNextBlock reads each once per sub-block
+        // (smoothed), so a fast bend never costs more than the block's one pitch update.
+        juce::SmoothedValue<float> pitchBend;       // -1..1, this note's channel (per-note in MPE)
+        juce::SmoothedValue<float> masterPitchBend; // -1..1, MPE master channel
+        juce::SmoothedValue<float> modWheel;        // CC 1
+        juce::SmoothedValue<float> pressure;        // Channel / poly aftertouch
+        juce::SmoothedValue<float> timbre;          // CC 74 (MPE slide)
+        float heldModWheel = 0.0f, heldTimbre = 0.0f, heldPressure = 0.0f; // The channel's, at Note On
+        float pitchBendRange = 2.0f;                // Semitones
+        float masterPitchBendRange = 2.0f;
+        static constexpr double expressionSmoothingSeconds = 0.005;
+        
+        static float wheelToBend(int wheelValue) { return juce::jlimit(-1.0f, 1.0f, (wheelValue - 8192) / 8191.0f); }
+        
         int currentNoteNumber = 60; // For KeyTracking
         
         float vcfKybdAmount = 0.0f; 
@@ -91,12 +166,34 @@ namespace voice
             return std::pow(value, factor);
         }
         
-        // Drift
-        DeepMindDSP::DriftGen driftGen;
+        // Drift (one lane per oscillator + filter)
+        DeepMindDSP::DriftBank driftBank;
         float driftAmount = 0.0f;
         
+        // Silence Tracking
+        float silenceThresholdGain = juce::Decibels::decibelsToGain(-96.0f);
+        double silenceHoldSeconds = 0.05;
+        int silenceSamplesToEnd = 2205;
+        int silentSampleCount = 0;
+        
         // Control Sequencer
         DeepMindDSP::ControlSequencer ctrlSeq;
-        std::vector<std::atomic<float>*> seqStepParams; // Cache to avoid string allocs in process
+        
+        // Parameter cache (attachParameters); nullptr = parameter not in the layout
+        using Param = std::atomic<float>*;
+        struct Parameters
+        {
+            Param dco1Pwm = nullptr;
+            Param vcfFreq = nullptr, vcfRes = nullptr, vcfKybd = nullptr, vcfType = nullptr, vcfTwoPole = nullptr;
+            Param vcaEnv[4] {}, vcfEnv[4] {}, modEnv[4] {}; // Attack, decay, sustain, release
+            Param vcaCurve = nullptr, vcfCurve = nullptr, modCurve = nullptr;
+            Param modSlots[8][3] {};                          // Source, destination, amount
+            Param lfo1Rate = nullptr, lfo1Delay = nullptr, lfo1Shape = nullptr;
+            Param lfo2Rate = nullptr, lfo2Delay = nullptr, lfo2Shape = nullptr;
+            Param polyphonyMode = nullptr, unisonDetune = nullptr, unisonWidth = nullptr;
+            Param drift = nullptr;
+            Param seqRate = nullptr, seqSlew = nullptr, seqSteps = nullptr, seqSwing = nullptr;
+            Param seqSteps32[32] {};
+        } params;
     };
 }